@@ -0,0 +1,48 @@
+#pragma once
+
+#include "datatypes.hpp"
+#include "delta_evaluation.hpp"
+
+// Batch scoring of many Swap / Relocate candidates on the same base tour.
+// Both moves replace at most four arcs. When none of the removed or added arcs
+// takes part in a relation, the delta is just (added arc costs) - (removed arc
+// costs): both sums are accumulated slot by slot with AVX-512 / AVX2 gathers when the CPU
+// has them (scalar loop otherwise), straight from the costs of the compact instance.
+// The other candidates go through the exact DeltaEvaluator.
+
+enum class MoveType {
+    SWAP,       // swap the nodes at positions i and j
+    RELOCATE    // move the node at position i to position j
+};
+
+// positions are in the depot-anchored sequence and never 0
+struct CandidateMove {
+    MoveType type;
+    int i;
+    int j;
+    double delta;   // filled by evaluateMoves, infinity if the move uses a missing arc
+};
+
+// arc costs and the arc lookup are read from graph.compact and graph.adj,
+// so every array here is O(n + number of candidates)
+struct BatchEvaluator {
+    DeltaEvaluator ev;
+
+    vector<double> removed_cost;        // cost_at of the base tour + [n] = 0 (padding position)
+
+    // structure of arrays: slot s of candidate c is at [s * stride + c]; unused slots
+    // add the padding arc (original_cost[num_arcs] = 0) and remove position n
+    vector<int> added;
+    vector<int> removed;
+    vector<int> exact;                  // candidates that need the exact evaluator
+    vector<int> missing;                // candidates that use a missing arc
+};
+
+// loads the base tour, reusing the arrays of the previous one; false if the tour is
+// infeasible (no delta can be computed from it)
+bool initBatchEvaluator(BatchEvaluator& be, Tour& tour, Graph& graph);
+
+void evaluateMoves(BatchEvaluator& be, Graph& graph, vector<CandidateMove>& moves);
+
+// index of the lowest delta, ties broken by position; -1 if there are no moves
+int selectBestMove(const vector<CandidateMove>& moves);
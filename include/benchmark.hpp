@@ -0,0 +1,40 @@
+#pragma once
+
+// Multi-seed benchmarking: R independent runs of one configuration, in parallel,
+// with time-to-target measurements for a list of target costs.
+
+#include "datatypes.hpp"
+#include "tatsp.hpp"
+
+#include <ostream>
+
+struct BenchmarkConfig {
+    int runs = 10;
+    int threads = 0;                    // 0 uses every hardware thread
+    unsigned int base_seed = 1;         // run r uses seed base_seed + r
+    vector<double> targets;             // a run reaches a target once its best cost is <= target
+};
+
+struct BenchmarkRun {
+    unsigned int seed = 0;
+    double best_cost = numeric_limits<double>::infinity();
+    int iterations = 0;
+    double elapsed = 0.0;
+    vector<double> time_to_target;      // one entry per target, infinity if it was not reached
+};
+
+struct BenchmarkResult {
+    vector<BenchmarkRun> runs;
+};
+
+// the configuration must not write shared state (checkpoint file, island segment);
+// returns -1 if it is invalid for a benchmark
+int runBenchmark(const Graph& graph, const vector<Arc>& all_arcs, const SolverConfig& config,
+                 const BenchmarkConfig& bench, BenchmarkResult& result);
+
+// one line per (run, target), with the empirical probability of the TTT plot:
+// the k-th fastest of the R runs to reach a target gets (k - 0.5) / R
+void writeBenchmarkCSV(ostream& out, const BenchmarkConfig& bench, const BenchmarkResult& result);
+
+// best / mean / median cost, iterations per second and time-to-target summary
+void printBenchmarkSummary(const BenchmarkConfig& bench, const BenchmarkResult& result);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "datatypes.hpp"
+
+#include <random>
+#include <string>
+
+// Plain-text checkpoint, one record per line:
+//   TATSP_CHECKPOINT 1
+//   <n> <pool size> <number of rng states>
+//   <best cost> <n nodes of the best tour, starting at the depot>
+//   <cost> <n nodes>                 (one line per pool member)
+//   <mt19937 state>                  (one line per generator)
+const string CHECKPOINT_HEADER = "TATSP_CHECKPOINT";
+const int CHECKPOINT_VERSION = 1;
+
+// writes to <filename>.tmp first and renames it, so an interrupted write never leaves a truncated checkpoint
+bool writeCheckpoint(const string& filename, Tour& best_tour, vector<Tour>& pool, const vector<mt19937*>& rngs);
+
+// tours that fail validation are dropped; rng states are restored only if their number matches
+bool readCheckpoint(const string& filename, Graph& graph, Tour& best_tour, vector<Tour>& pool,
+                    const vector<mt19937*>& rngs);
+
+// reads a tour given as node ids separated by commas or whitespace (e.g. the "Best Tour Path" line)
+bool readTourFile(const string& filename, Graph& graph, Tour& tour);
+
+// checks the tour is a feasible permutation of the nodes, rotates it to start at the depot and recomputes its cost
+bool validateTour(Tour& tour, Graph& graph);
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "datatypes.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+// The instance as the search reads it, in the narrowest types that represent it exactly
+// (chooseCompactLayout):
+//   - graph.adj (ArcMatrix, tatsp_types.hpp) is the n x n lookup, in node-sized ranks;
+//   - arc ids in the relation lists take 16 bits when there are fewer than 65535 arcs;
+//   - costs are int32 when every arc and relation cost is an integer in int32 range.
+// The relations of each arc are contiguous, both by trigger (targets) and by target
+// (triggers). buildInstance builds it once and every copy of the Graph shares it.
+// Tour costs and deltas are computed from it alone: all_arcs is only read by the
+// construction, whose perturbed costs never reach the evaluation.
+
+enum class IndexWidth {
+    U16,
+    U32
+};
+
+enum class CostKind {
+    INT32,  // every arc and relation cost is an integer in int32 range
+    DOUBLE
+};
+
+struct CompactLayout {
+    IndexWidth node;    // ranks and arc tails of graph.adj: n and every out-degree below 65535
+    IndexWidth arc;     // arc ids of the relation lists: fewer than 65535 arcs
+    CostKind cost;
+};
+
+struct CompactInstanceBase {
+    CompactLayout layout;
+    uint64_t id;        // unique per instance, keys the per-thread evaluation scratch
+    ArcMatrix adj;      // graph.adj, same arrays
+    size_t num_arcs;
+
+    virtual ~CompactInstanceBase() = default;
+
+    // same walk, bound and result as calculateTATSPcostBounded
+    virtual bool tourCost(const vector<int>& tour, double cutoff, double& cost) const = 0;
+
+    virtual size_t footprint() const = 0;   // bytes of all the instance arrays, graph.adj included
+};
+
+template <typename ArcId, typename Cost>
+struct CompactInstance : CompactInstanceBase {
+
+    // integer costs are summed exactly, as the double path does for integral values
+    using Sum = conditional_t<is_integral_v<Cost>, int64_t, double>;
+
+    struct Relation {
+        ArcId arc;
+        Cost cost;
+    };
+
+    vector<Cost> original_cost;     // by arc, plus a 0 at [num_arcs] (padding slot of the batch gathers)
+    vector<uint32_t> target_begin;  // arc a sets the costs of targets[target_begin[a] .. target_begin[a + 1])
+    vector<Relation> targets;
+    vector<uint32_t> trigger_begin; // arc b can be set by triggers[trigger_begin[b] .. trigger_begin[b + 1])
+    vector<Relation> triggers;      // in trigger order, so the later of two relations still wins
+    vector<Cost> min_out_cost;      // cheapest way to leave each node, over all triggers
+    Sum min_out_total;              // their sum, summed in node order
+
+    // no triggers and no targets: the arc always costs original_cost
+    bool plain(int a) const {
+        return target_begin[a] == target_begin[a + 1] && trigger_begin[a] == trigger_begin[a + 1];
+    }
+
+    bool tourCost(const vector<int>& tour, double cutoff, double& cost) const override;
+    size_t footprint() const override;
+};
+
+// calls f with the typed instance behind graph.compact, so the loops of the
+// evaluators are compiled once per layout instead of going through virtual calls
+template <typename F>
+decltype(auto) visitCompactInstance(const Graph& graph, F&& f) {
+    const CompactInstanceBase& compact = *graph.compact;
+    if (compact.layout.arc == IndexWidth::U16) {
+        if (compact.layout.cost == CostKind::INT32)
+            return f(static_cast<const CompactInstance<uint16_t, int32_t>&>(compact));
+        return f(static_cast<const CompactInstance<uint16_t, double>&>(compact));
+    }
+    if (compact.layout.cost == CostKind::INT32)
+        return f(static_cast<const CompactInstance<uint32_t, int32_t>&>(compact));
+    return f(static_cast<const CompactInstance<uint32_t, double>&>(compact));
+}
+
+CompactLayout chooseCompactLayout(int num_nodes, const vector<Arc>& all_arcs);
+
+// fills graph.adj and graph.compact; all_arcs must be sorted by (from, to) (buildInstance does it)
+void buildCompactInstance(int num_nodes, const vector<Arc>& all_arcs, Graph& graph);
+
+string describeCompactLayout(const CompactInstanceBase& compact);
@@ -7,12 +7,6 @@
 #include <string>
 #include <random>
 
-enum class PerturbationType {
-    NONE,           
-    ADDITIVE,
-    MULTIPLICATIVE
-};
-
 // alpha is the perturbation parameter for additive perturbation
 void additivePerturbation(vector<Arc>& all_arcs, double alpha, mt19937& gen);
 
@@ -25,7 +19,18 @@ int solveTSP(const Graph& graph, const vector<Arc>& all_arcs, Tour& solution_tou
 int constructiveHeuristic(Graph& graph, vector<Arc>& all_arcs, Tour& solution_tour, 
                            PerturbationType pert_type, double pert_parameter, mt19937& gen);
                            
-void calculateTATSPcost(Tour& solution_tour, vector<Arc>& all_arcs, Graph& graph);
+// prices the tour from graph.compact, i.e. from the costs buildInstance was given:
+// all_arcs is not read, so its perturbed costs never leak into tour costs.
+// A tour that uses a missing arc costs infinity.
+void calculateTATSPcost(Tour& solution_tour, Graph& graph);
+
+// calculateTATSPcost that gives up once the partial cost plus a lower bound on the
+// arcs still to traverse (the cheapest way out of each node left) reaches cutoff;
+// the tour cost is then set to infinity. Returns true if the tour costs less than cutoff.
+bool calculateTATSPcostBounded(Tour& solution_tour, Graph& graph, double cutoff);
+
+// rotates the tour to start at the depot and rebuilds pos (the tour must be a permutation of the nodes)
+void anchorTour(Tour& tour);
 
 // modified mod to handle negative int properly
 int modified_mod(int a, int b);
\ No newline at end of file
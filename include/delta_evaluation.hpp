@@ -0,0 +1,47 @@
+#pragma once
+
+#include "datatypes.hpp"
+
+// Incremental TA-TSP cost evaluation. A move is described as the replacement of the
+// nodes at positions [first, last] of the depot-anchored sequence; only the arcs
+// entering, inside and leaving that segment, plus the later arcs targeted by them,
+// are re-priced, instead of walking the whole cycle.
+// Costs and relations are read from graph.compact. An arc is located through its tail
+// (graph.adj.tail), so every array here has n entries, whatever the number of arcs.
+struct DeltaEvaluator {
+    vector<int> seq;          // depot-anchored node sequence, seq[0] == 0
+    vector<int> pos;          // pos[node] is the index of node in seq
+    vector<int> arc_at;       // arc_at[k] is the arc from seq[k] to seq[(k + 1) % n]
+    vector<double> cost_at;   // trigger-adjusted cost of arc_at[k]
+    double tour_cost;
+
+    // scratch space of evaluateSegmentDelta
+    vector<int> new_pos;      // by node: position of its outgoing arc in the candidate tour
+    vector<int> new_stamp;    // by node: new_pos is valid for the current candidate
+    vector<int> seen_stamp;   // by position: later arc already re-priced
+    vector<int> new_arcs;
+    int stamp = 0;
+};
+
+// returns false (and leaves the evaluator empty) if the tour is infeasible; O(n), and the
+// arrays of a previous tour are reused, so one evaluator can be reloaded cheaply
+bool initDeltaEvaluator(DeltaEvaluator& ev, Tour& tour, Graph& graph);
+
+// recomputes pos/arc_at/cost_at/tour_cost from ev.seq
+void rebuildDeltaEvaluator(DeltaEvaluator& ev, Graph& graph);
+
+// position of arc a in the evaluator's tour, -1 if the tour does not use it
+int arcPosition(const DeltaEvaluator& ev, const Graph& graph, int a);
+
+// cost change of writing new_nodes over positions [first, last] (1 <= first <= last < n);
+// infinity if the resulting tour uses a missing arc
+double evaluateSegmentDelta(DeltaEvaluator& ev, Graph& graph, int first, int last, const vector<int>& new_nodes);
+
+void commitSegment(DeltaEvaluator& ev, Graph& graph, int first, const vector<int>& new_nodes);
+
+// segment contents of the three classic moves, positions are in the anchored sequence
+void swapSegment(DeltaEvaluator& ev, int i, int j, vector<int>& new_nodes);        // swap seq[i] and seq[j], i < j
+void relocateSegment(DeltaEvaluator& ev, int from, int to, vector<int>& new_nodes); // move seq[from] to position to
+void reverseSegment(DeltaEvaluator& ev, int i, int j, vector<int>& new_nodes);     // reverse seq[i..j], i < j
+
+Tour evaluatorTour(const DeltaEvaluator& ev);
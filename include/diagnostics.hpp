@@ -0,0 +1,22 @@
+#pragma once
+
+#include <ostream>
+
+// Error and warning messages of the library modules go to diagnostics() instead of cerr.
+// They are silent unless the program enables them on its thread (main does, for the
+// command line tool); solveTATSP enables them for the length of a call with
+// SolverConfig::verbose. Failures are reported by the return values either way.
+
+// cerr while enabled on this thread, otherwise a stream that discards everything
+std::ostream& diagnostics();
+
+// enables or silences diagnostics() on the current thread, restored on destruction
+struct DiagnosticsScope {
+    explicit DiagnosticsScope(bool enabled);
+    ~DiagnosticsScope();
+
+    DiagnosticsScope(const DiagnosticsScope&) = delete;
+    DiagnosticsScope& operator=(const DiagnosticsScope&) = delete;
+
+    bool previous;
+};
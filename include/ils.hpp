@@ -0,0 +1,32 @@
+#pragma once
+
+#include "datatypes.hpp"
+
+#include <random>
+
+// number of random cut points tried before a kick gives up
+const int MAX_KICK_ATTEMPTS = 100;
+
+struct ILSState {
+    Tour current;
+    Tour best;
+    bool initialized = false;
+};
+
+void initILS(ILSState& state, Tour& start_solution);
+
+// exchanges two consecutive segments (A B C D -> A C B D), only the three new arcs need checking
+bool doubleBridgeKick(Tour& tour, Graph& graph, mt19937& gen);
+
+// reverses a random segment through applyTwoOptMove
+bool segmentReversalKick(Tour& tour, Graph& graph, mt19937& gen);
+
+// picks one of the two kicks at random, falling back to the other if no feasible cut was found
+bool kickSolution(Tour& tour, Graph& graph, mt19937& gen);
+
+bool acceptSolution(Tour& candidate, ILSState& state, AcceptanceCriterion acceptance, double threshold);
+
+// one kick + improveSolution with the given engine + acceptance; returns true if the best solution improved.
+// gen drives both the kick and the engine
+bool ilsStep(ILSState& state, Graph& graph, AcceptanceCriterion acceptance, double threshold,
+             const EngineConfig& engine, mt19937& gen);
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "datatypes.hpp"
+
+#include <random>
+
+// final/initial SA temperature ratio
+const double SA_FINAL_TEMPERATURE_RATIO = 1e-3;
+
+// number of random moves sampled to calibrate the initial SA temperature
+const int SA_CALIBRATION_MOVES = 100;
+
+// default iteration budgets: one SA iteration is a single sampled move,
+// one tabu iteration scans the candidate-list neighbourhood
+const long SA_DEFAULT_ITERATIONS = 100000;
+const long TABU_DEFAULT_ITERATIONS = 200;
+
+// tabu only tries the moves that make a node followed by one of its
+// TABU_CANDIDATES cheapest successors
+const int TABU_CANDIDATES = 10;
+
+// fills in SA_DEFAULT_ITERATIONS / TABU_DEFAULT_ITERATIONS when no budget was given;
+// simulatedAnnealing and tabuSearch apply it themselves, so a budget of 0 means the default
+void applyDefaultBudget(EngineConfig& config);
+
+// stand-in for localSearch inside the GRASP loop
+void improveSolution(Tour& current_solution, Graph& graph, const EngineConfig& config, mt19937& gen);
+
+void simulatedAnnealing(Tour& current_solution, Graph& graph, const EngineConfig& config, mt19937& gen);
+
+void tabuSearch(Tour& current_solution, Graph& graph, const EngineConfig& config, mt19937& gen);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "datatypes.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// number of migrant slots in the shared ring buffer
+const uint32_t ISLAND_RING_CAPACITY = 64;
+
+const uint32_t ISLAND_MAGIC = 0x54415350; // "TASP"
+
+// Shared memory layout: a header followed by ISLAND_RING_CAPACITY slots of
+// sizeof(MigrantSlot) + num_nodes ints each. Writers claim slots with a ticket
+// counter; each slot carries a seqlock (odd while being written) so readers can
+// detect a slot that was overwritten while they copied it.
+struct IslandSegmentHeader {
+    atomic<uint32_t> magic;
+    uint32_t num_nodes;
+    uint32_t capacity;
+    uint32_t slot_size;
+    atomic<uint64_t> write_ticket;
+    atomic<int32_t> attached;       // islands currently mapped, the last one unlinks the segment
+};
+
+struct MigrantSlot {
+    atomic<uint64_t> sequence;      // 2 * ticket + 2 once the migrant of that ticket is complete
+    int32_t source;                 // island id of the sender
+    double cost;
+    // followed by num_nodes ints, starting at the depot
+};
+
+struct Island {
+    string name;
+    int id = -1;
+    int fd = -1;
+    size_t size = 0;
+    IslandSegmentHeader* header = nullptr;
+    uint64_t next_ticket = 0;       // first ticket this island has not read yet
+};
+
+// creates the segment (first island) or attaches to it; false on failure or size mismatch
+bool attachIsland(Island& island, const string& name, int id, int num_nodes);
+
+void detachIsland(Island& island);
+
+void sendMigrant(Island& island, Tour& tour);
+
+// appends every migrant published by other islands since the last call
+void receiveMigrants(Island& island, vector<Tour>& migrants);
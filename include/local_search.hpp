@@ -1,10 +1,12 @@
 #pragma once
 
 #include "datatypes.hpp"
+#include "batch_evaluation.hpp"
 
-void localSearch(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph);
+// dp_window > 0 adds the window DP reorder (window_dp.hpp) as a last neighborhood
+void localSearch(Tour& current_solution, Graph& graph, int dp_window = 0);
 
-bool twoOpt(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph);
+bool twoOpt(Tour& current_solution, Graph& graph);
 
 Tour applyTwoOptMove(Tour& tour, Graph& graph, int arc1_source, int arc2_source);
 
@@ -12,8 +14,9 @@ Tour applySwapTwoMove(Tour& tour, int idx1, int idx2);
 
 Tour applyRelocateMove(Tour& tour, int idx1, int idx2);
 
-bool swapTwo(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph);
+// be is scratch space, reloaded with the current solution (localSearch keeps one per call)
+bool swapTwo(Tour& current_solution, Graph& graph, BatchEvaluator& be);
 
-bool relocate(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph);
+bool relocate(Tour& current_solution, Graph& graph, BatchEvaluator& be);
 
 bool checkTourFeasibility(Tour& tour, const Graph& graph);
\ No newline at end of file
@@ -1,8 +1,15 @@
 #pragma once
 
-#include "datatypes.hpp"
-#include <iostream>
-#include <fstream>
+// instance loading, also part of libtatsp's public interface (tatsp.hpp)
+
+#include "tatsp_types.hpp"
 #include <string>
+#include <vector>
+
+void parser(const std::string& filename, Graph& graph, std::vector<Arc>& all_arcs);
 
-void parser(const string& filename, Graph& graph, vector<Arc>& all_arcs);
\ No newline at end of file
+// builds the Graph / Arc representation used by the search from an in-memory instance.
+// all_arcs comes out sorted by (from, to), with the relations renumbered to match;
+// arc_order (if given) receives the input index of each arc
+void buildInstance(int num_nodes, const std::vector<InstanceArc>& arcs, const std::vector<InstanceRelation>& relations,
+                   Graph& graph, std::vector<Arc>& all_arcs, std::vector<int>* arc_order = nullptr);
@@ -1,12 +1,21 @@
 #pragma once
 
 #include "datatypes.hpp"
+#include "batch_evaluation.hpp"
 
 #include <random> 
 
-void applyPathRelinkingMove(Tour& initial_solution, Tour& guiding_solution, Graph& graph, vector<Arc>& all_arcs);
+// be is scratch space, reloaded with the current solution (mixedPathRelinking keeps one per path)
+void applyPathRelinkingMove(Tour& initial_solution, Tour& guiding_solution, Graph& graph, BatchEvaluator& be);
 
-Tour mixedPathRelinking(Tour solution1, Tour solution2, Graph& graph, vector<Arc>& all_arcs);
+// intermediates (if given) receives every tour that improved the best one found along the path
+Tour mixedPathRelinking(Tour solution1, Tour solution2, Graph& graph, vector<Tour>* intermediates = nullptr);
+
+// relinks solution with each of the `guides` cheapest pool members, starting from either end;
+// the relinkings are shared by at most max_workers workers (0: hardware_concurrency), the
+// calling thread included, which only read the graph. Returns the best tour found
+Tour multiGuidePathRelinking(Tour& solution, vector<Tour>& pool, int guides, int max_workers, Graph& graph,
+                             vector<Tour>& intermediates);
 
 int calculateHammingDistance(Tour& solution1, Tour& solution2);
 
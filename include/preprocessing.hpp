@@ -0,0 +1,27 @@
+#pragma once
+
+#include "datatypes.hpp"
+
+// Exact reductions applied before the search (every feasible tour keeps its cost):
+//   - self-loops and arcs ruled out by forced arcs are removed. A node with a single
+//     outgoing (incoming) arc forces it, which removes the other arcs into its head
+//     (out of its tail) and the arc closing the forced path into a subtour
+//   - relations that can never fire are dropped: the trigger can never be traversed
+//     before the target (target leaves the depot, trigger enters it, trigger starts
+//     where the target ends away from the depot, both share a tail or a head), or every trigger of the
+//     target sets its original cost again
+//   - paths of forced arcs without relations are contracted into one node; the
+//     node holding the depot becomes node 0 and arcs / nodes are renumbered compactly
+// The Reduction record itself is in tatsp_types.hpp (it is part of SolverStats).
+
+// returns -1 if the forced arcs show the instance has no Hamiltonian cycle (the reduced instance is then not built)
+int preprocessInstance(const Graph& graph, const vector<Arc>& all_arcs,
+                       Graph& reduced_graph, vector<Arc>& reduced_arcs, Reduction& reduction);
+
+// reduced tour -> original node ids, starting at the depot, with the original cost
+void expandTour(const Reduction& reduction, const Tour& reduced_tour, Tour& tour);
+
+// original tour (feasible, with its exact cost) -> reduced tour; false if it breaks a contracted path
+bool reduceTour(const Reduction& reduction, const Tour& tour, Tour& reduced_tour);
+
+void printReduction(const Reduction& reduction);
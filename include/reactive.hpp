@@ -0,0 +1,26 @@
+#pragma once
+
+#include "datatypes.hpp"
+#include "construction.hpp"
+
+#include <random>
+
+// number of GRASP iterations between two probability updates
+const int REACTIVE_BLOCK = 20;
+
+// amplification exponent (delta) used when turning mean costs into probabilities
+const double REACTIVE_DELTA = 10.0;
+
+// builds the candidate set around base_param with a uniform distribution
+void initReactiveGRASP(ReactiveGRASP& reactive, double base_param);
+
+// roulette selection of an option index according to the current probabilities
+int selectReactiveOption(ReactiveGRASP& reactive, mt19937& gen);
+
+// stores the cost of a tour built with option_idx and updates the probabilities every REACTIVE_BLOCK calls
+void recordReactiveResult(ReactiveGRASP& reactive, int option_idx, double tour_cost);
+
+// p_i = q_i / sum(q), with q_i = (best_cost / mean_cost_i)^REACTIVE_DELTA (Prais & Ribeiro, 2000)
+void updateReactiveProbabilities(ReactiveGRASP& reactive);
+
+void printReactiveDistribution(const ReactiveGRASP& reactive);
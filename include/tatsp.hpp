@@ -0,0 +1,69 @@
+#pragma once
+
+// libtatsp: the GRASP+PR search behind the solver executable, callable in-process.
+// Self-contained: it only needs the standard library and adds no using-directive.
+
+#include "tatsp_types.hpp"
+#include "parser.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define TATSP_API_VERSION 1
+
+const std::size_t POOL_SIZE = 10;
+
+struct SolverConfig {
+    PerturbationType pert_type = PerturbationType::ADDITIVE;
+    double pert_parameter = 0.0;
+    double time_limit = 60.0;
+    bool path_relinking = false;
+    int pr_guides = 1;                  // > 1 relinks against that many of the best pool members in parallel
+    int pr_threads = 0;                 // workers of those relinkings, 0 uses every hardware thread
+    bool reactive = false;              // pert_parameter becomes the base scale of the candidate set
+
+    int ils_kicks = 0;                  // ILS steps after each GRASP iteration
+    bool ils_only = false;              // one construction, then only ILS steps
+    AcceptanceCriterion acceptance = AcceptanceCriterion::BETTER;
+    double ils_threshold = 0.01;
+
+    EngineConfig engine;
+
+    std::string checkpoint_file;        // empty disables checkpoints
+    double checkpoint_interval = 60.0;
+    std::string resume_file;
+    std::string init_file;
+
+    std::string island_name;            // shared memory segment of the island model, empty disables it
+    int island_id = 0;
+    int migration_interval = 10;        // iterations between two exchanges
+    MigrationPolicy migration_policy = MigrationPolicy::BEST;
+
+    bool preprocess = false;            // search on the reduced instance (tours are still reported with the original ids)
+
+    unsigned int seed = 0;              // 0 draws the seeds from random_device
+    bool verbose = false;               // progress messages on cout, error messages on cerr
+};
+
+struct SolverStats {
+    int iterations = 0;
+    int best_iteration = 0;
+    double elapsed = 0.0;
+    ReactiveGRASP reactive;             // learned distribution, only filled in reactive mode
+    Reduction reduction;                // only filled when preprocessing
+};
+
+struct SolverResult {
+    Tour best_tour;                     // empty if no feasible tour was found
+    SolverStats stats;
+};
+
+// called when the incumbent is first set (a warm start included) and each time it improves
+using ImprovementCallback = std::function<void(const Tour& tour, int iteration, double elapsed)>;
+
+// runs the search on private copies of the instance, so concurrent calls may share it;
+// returns 0 on success (even if no tour was found) and -1 if the configuration is invalid
+int solveTATSP(const Graph& graph, const std::vector<Arc>& all_arcs, const SolverConfig& config,
+               SolverResult& result, ImprovementCallback on_improvement = nullptr);
@@ -0,0 +1,108 @@
+#ifndef TATSP_C_H
+#define TATSP_C_H
+
+/* C interface of libtatsp, see tatsp.hpp for the C++ one. */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TATSP_C_API_VERSION 6
+
+/* pert_type */
+#define TATSP_PERT_NONE 0
+#define TATSP_PERT_ADDITIVE 1
+#define TATSP_PERT_MULTIPLICATIVE 2
+
+/* acceptance */
+#define TATSP_ACCEPT_BETTER 0
+#define TATSP_ACCEPT_RANDOM_WALK 1
+#define TATSP_ACCEPT_THRESHOLD 2
+
+/* engine */
+#define TATSP_ENGINE_LOCAL_SEARCH 0
+#define TATSP_ENGINE_SIMULATED_ANNEALING 1
+#define TATSP_ENGINE_TABU_SEARCH 2
+
+typedef struct tatsp_arc {
+    int from;
+    int to;
+    double cost;
+} tatsp_arc;
+
+typedef struct tatsp_relation {
+    int trigger_arc;
+    int target_arc;
+    double new_cost;
+} tatsp_relation;
+
+/*
+ * file names may be NULL, seed 0 draws the seeds from random_device.
+ * Version 5 changed the layout (struct_size was inserted first), so programs built
+ * against versions 1 to 4 must be recompiled. From version 5 on fields are only
+ * appended: struct_size, set by tatsp_default_config to the size the caller was
+ * compiled with, tells the library which ones the caller has, the others keep
+ * their defaults.
+ */
+typedef struct tatsp_config {
+    size_t struct_size; /* sizeof(tatsp_config) of the caller */
+    int pert_type;
+    double pert_parameter;
+    double time_limit;
+    int path_relinking;
+    int reactive;
+    int ils_kicks;
+    int ils_only;
+    int acceptance;
+    double ils_threshold;
+    int engine;
+    long engine_iterations;     /* both 0: the engine's default iteration budget */
+    double engine_time_limit;
+    int tabu_tenure;
+    const char* checkpoint_file;
+    double checkpoint_interval;
+    const char* resume_file;
+    const char* init_file;
+    unsigned int seed;
+    int preprocess;
+    int dp_window;      /* 0 disables the window DP */
+    int pr_guides;      /* > 1 relinks against several guides in parallel */
+    int pr_threads;     /* since version 6, workers of those relinkings, 0 uses every hardware thread */
+} tatsp_config;
+
+typedef struct tatsp_stats {
+    int iterations;
+    int best_iteration;
+    double elapsed;
+} tatsp_stats;
+
+/* called when the incumbent is first set (warm starts included) and each time it improves, tour holds num_nodes node ids starting at the depot and is only valid during the call */
+typedef void (*tatsp_callback)(const int* tour, int num_nodes, double cost,
+                               int iteration, double elapsed, void* user_data);
+
+/* fills the first struct_size bytes of config with the defaults, use tatsp_default_config */
+void tatsp_init_config(tatsp_config* config, size_t struct_size);
+
+#define tatsp_default_config(config) tatsp_init_config((config), sizeof(tatsp_config))
+
+/*
+ * Solves the instance given by arcs (indexed by position) and relations.
+ * best_tour must hold num_nodes ints. Returns 0 if a tour was found,
+ * 1 if none was found within the time limit and -1 on invalid input
+ * (including a config not initialized by tatsp_default_config) or on an
+ * internal error; no C++ exception leaves this function.
+ */
+int tatsp_solve(int num_nodes,
+                const tatsp_arc* arcs, int num_arcs,
+                const tatsp_relation* relations, int num_relations,
+                const tatsp_config* config,
+                tatsp_callback callback, void* user_data,
+                int* best_tour, double* best_cost, tatsp_stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
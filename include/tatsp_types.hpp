@@ -0,0 +1,160 @@
+#pragma once
+
+// Data types shared by libtatsp's public header (tatsp.hpp) and the solver modules.
+// This header is included by library clients, so it names std:: explicitly and
+// pulls in nothing but the standard library.
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+struct Arc {
+    int from;
+    int to;
+    double original_cost;
+    double current_cost;
+    std::vector<std::pair<int, double>> targets; //(target index, new cost for the target)
+    std::vector<int> triggers; //trigger for the arc
+
+};
+
+// in-memory instance description, arcs are indexed by their position in the vector
+struct InstanceArc {
+    int from;
+    int to;
+    double cost;
+};
+
+struct InstanceRelation {
+    int trigger_arc;
+    int target_arc;
+    double new_cost;    // cost of target_arc once trigger_arc has been traversed
+};
+
+// n x n arc lookup: adj[u][v] is the arc from u to v, -1 if there is none.
+// buildInstance numbers the arcs by tail, so an entry only holds the rank of the arc
+// among those leaving u. Ranks and arc tails are node-sized: 16 bits when n and every
+// out-degree are below 65535, 32 bits otherwise. Copies share the arrays.
+struct ArcMatrix {
+    int n = 0;
+    bool wide = false;                          // 32-bit ranks and tails
+    const int* first_out = nullptr;             // arcs leaving u are [first_out[u], first_out[u + 1])
+    const std::uint16_t* ranks16 = nullptr;     // n * n ranks, all bits set where there is no arc
+    const std::uint32_t* ranks32 = nullptr;
+    const std::uint16_t* tails16 = nullptr;     // tail of each arc
+    const std::uint32_t* tails32 = nullptr;
+    std::shared_ptr<const void> storage;        // owns the arrays above
+
+    std::size_t size() const { return n; }
+
+    int arc(int u, int v) const {
+        std::size_t k = (std::size_t)u * n + v;
+        if (wide)
+            return (ranks32[k] == UINT32_MAX) ? -1 : first_out[u] + (int)ranks32[k];
+        return (ranks16[k] == UINT16_MAX) ? -1 : first_out[u] + ranks16[k];
+    }
+
+    int tail(int a) const { return wide ? (int)tails32[a] : tails16[a]; }
+
+    struct Row {
+        const ArcMatrix& matrix;
+        int u;
+        int operator[](int v) const { return matrix.arc(u, v); }
+    };
+
+    Row operator[](int u) const { return {*this, u}; }
+};
+
+struct CompactInstanceBase;
+
+struct Graph {
+    ArcMatrix adj;
+    std::shared_ptr<const CompactInstanceBase> compact; // costs and relations in narrow types (filled by buildInstance, see compact_instance.hpp)
+};
+
+// tours always start at the depot (tour[0] == 0), so position k is the k-th node
+// visited; every move applier keeps pos up to date (anchorTour rebuilds both)
+struct Tour {
+    std::vector<int> tour;
+    std::vector<int> pos;    // pos[node] is the index of node in tour
+    double tour_cost;
+
+    bool operator==(const Tour& other) const {
+        return tour_cost == other.tour_cost && tour == other.tour;
+    }
+
+    bool operator!=(const Tour& other) const {
+        return !(*this == other);
+    }
+
+};
+
+enum class PerturbationType {
+    NONE,
+    ADDITIVE,
+    MULTIPLICATIVE
+};
+
+enum class AcceptanceCriterion {
+    BETTER,         // accept only improvements over the current solution
+    RANDOM_WALK,    // accept every kicked local optimum
+    THRESHOLD       // accept anything within (1 + threshold) of the best solution
+};
+
+enum class ImprovementEngine {
+    LOCAL_SEARCH,           // localSearch: 2-Opt, Swap and Relocate down to a local optimum
+    SIMULATED_ANNEALING,
+    TABU_SEARCH
+};
+
+// a budget of 0 means "no limit"; when both are 0, SA and tabu use their default
+// iteration budget (applyDefaultBudget, improvement.hpp)
+struct EngineConfig {
+    ImprovementEngine engine = ImprovementEngine::LOCAL_SEARCH;
+    long max_iterations = 0;
+    double time_limit = 0;
+    int tabu_tenure = 0;    // 0 picks 7 + n / 10
+    int dp_window = 0;      // window of the DP reorder in localSearch, 0 disables it
+};
+
+enum class MigrationPolicy {
+    BEST,           // send the island's best tour
+    RANDOM_ELITE    // send a random member of the elite pool
+};
+
+// one candidate (perturbation type, parameter) pair of the reactive scheme
+struct ReactiveOption {
+    PerturbationType type;
+    double param;
+    double probability;
+    double cost_sum = 0; // sum of the costs of the tours built with this option
+    int count = 0;       // number of tours built with this option
+};
+
+struct ReactiveGRASP {
+    std::vector<ReactiveOption> options;
+    double best_cost = std::numeric_limits<double>::infinity();
+    int iterations_since_update = 0;
+};
+
+// what preprocessInstance removed, and how to map reduced tours back (see preprocessing.hpp)
+struct Reduction {
+    int original_nodes = 0;
+    int original_arcs = 0;
+    int original_relations = 0;
+
+    int reduced_nodes = 0;
+    int reduced_arcs = 0;
+    int reduced_relations = 0;
+
+    int forced_arcs = 0;
+    int contracted_arcs = 0;
+    double fixed_cost = 0.0;            // cost of the contracted arcs, paid by every tour
+
+    std::vector<std::vector<int>> node_chain;     // original nodes of each reduced node, in tour order
+    std::vector<int> node_group;             // reduced node of each original node
+    std::vector<int> arc_origin;             // original index of each reduced arc
+};
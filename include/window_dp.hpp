@@ -0,0 +1,29 @@
+#pragma once
+
+#include "datatypes.hpp"
+#include "delta_evaluation.hpp"
+
+// Window reoptimization: the k nodes at positions [first, first + k - 1] of the
+// depot-anchored sequence are reordered with a Held-Karp DP over (visited set, last node),
+// between the fixed node before the window and the one after it. Arc costs in the DP
+// take the triggers of the fixed prefix into account, but the (set, last node) state
+// cannot know which window arcs come first: the DP order is only optimal when no
+// relation has both its trigger and its target among the arcs entering, inside or
+// leaving the window. Otherwise it is a heuristic candidate, and in every case the
+// exact delta (window and suffix included) decides whether a reorder is kept.
+const int DP_WINDOW_MIN = 3;
+const int DP_WINDOW_MAX = 16;
+
+// DP tables, reused across windows: entry [S * k + v] is the best path from the
+// node before the window through the set S, ending at window node v
+struct WindowDPTable {
+    vector<double> cost;
+    vector<unsigned char> parent;
+    vector<double> arc_cost;        // k x k prefix-aware costs inside the window
+    vector<unsigned int> succ;      // window nodes reachable from each window node
+};
+
+// slides the window along the tour, applies the first improving reorder; true if one was found.
+// ev must hold current_solution (localSearch passes the evaluator relocate has just loaded)
+// and is kept in sync with it
+bool windowDP(Tour& current_solution, Graph& graph, int window, DeltaEvaluator& ev);
@@ -0,0 +1,240 @@
+#include "batch_evaluation.hpp"
+#include "compact_instance.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TATSP_X86_SIMD 1
+#endif
+
+// number of arc slots per candidate (a Swap of non-adjacent nodes replaces four arcs)
+const int MOVE_SLOTS = 4;
+
+bool initBatchEvaluator(BatchEvaluator& be, Tour& tour, Graph& graph) {
+
+    if (!initDeltaEvaluator(be.ev, tour, graph))
+        return false;
+
+    be.removed_cost.assign(be.ev.cost_at.begin(), be.ev.cost_at.end());
+    be.removed_cost.push_back(0.0);
+
+    return true;
+}
+
+enum class SlotKind {
+    PLAIN,      // the delta is the sum of the slots
+    EXACT,      // an added or removed arc takes part in a relation
+    MISSING     // an added arc does not exist
+};
+
+// fills the four (added arc, removed position) slots of one candidate
+template <typename Instance>
+static SlotKind buildSlots(BatchEvaluator& be, const Instance& instance, const CandidateMove& move,
+                           size_t c, size_t stride) {
+
+    const vector<int>& s = be.ev.seq;
+    int n = s.size();
+    int padding = instance.num_arcs;
+    auto arc = [&](int u, int v) { return instance.adj.arc(u, v); };
+    auto next = [&](int p) { return s[(p + 1) % n]; };
+
+    int add[MOVE_SLOTS] = {padding, padding, padding, padding};
+    int rem[MOVE_SLOTS] = {n, n, n, n};
+
+    int i = move.i, j = move.j;
+
+    if (move.type == MoveType::SWAP) {
+        if (i > j)
+            swap(i, j);
+        if (j == i + 1) {
+            add[0] = arc(s[i - 1], s[j]); add[1] = arc(s[j], s[i]); add[2] = arc(s[i], next(j));
+            rem[0] = i - 1; rem[1] = i; rem[2] = j;
+        }
+        else {
+            add[0] = arc(s[i - 1], s[j]); add[1] = arc(s[j], s[i + 1]);
+            add[2] = arc(s[j - 1], s[i]); add[3] = arc(s[i], next(j));
+            rem[0] = i - 1; rem[1] = i; rem[2] = j - 1; rem[3] = j;
+        }
+    }
+    else if (i < j) {
+        add[0] = arc(s[i - 1], s[i + 1]); add[1] = arc(s[j], s[i]); add[2] = arc(s[i], next(j));
+        rem[0] = i - 1; rem[1] = i; rem[2] = j;
+    }
+    else {
+        add[0] = arc(s[j - 1], s[i]); add[1] = arc(s[i], s[j]); add[2] = arc(s[i - 1], next(i));
+        rem[0] = j - 1; rem[1] = i - 1; rem[2] = i;
+    }
+
+    SlotKind kind = SlotKind::PLAIN;
+    for (int k = 0; k < MOVE_SLOTS; ++k) {
+        if (add[k] == -1) {
+            kind = SlotKind::MISSING;
+            add[k] = padding;
+        }
+        else if (kind == SlotKind::PLAIN && ((add[k] != padding && !instance.plain(add[k])) ||
+                                             (rem[k] != n && !instance.plain(be.ev.arc_at[rem[k]])))) {
+            kind = SlotKind::EXACT;
+        }
+        be.added[k * stride + c] = add[k];
+        be.removed[k * stride + c] = rem[k];
+    }
+
+    return kind;
+}
+
+// same order of operations as the vector paths (each sum in slot order, then the difference),
+// so a candidate gets the same delta whichever path scores it
+template <typename Cost>
+static void accumulateScalar(const BatchEvaluator& be, const Cost* cost, size_t begin, size_t count, size_t stride,
+                             double* out) {
+    for (size_t c = begin; c < count; ++c) {
+        double added_sum = 0, removed_sum = 0;
+        for (int k = 0; k < MOVE_SLOTS; ++k) {
+            added_sum += (double)cost[be.added[k * stride + c]];
+            removed_sum += be.removed_cost[be.removed[k * stride + c]];
+        }
+        out[c] = added_sum - removed_sum;
+    }
+}
+
+#ifdef TATSP_X86_SIMD
+
+// masked gathers with every lane enabled (the unmasked ones leave the source undefined);
+// int32 costs are gathered as integers and widened
+__attribute__((target("avx2")))
+static inline __m256d gatherCosts4(const double* cost, __m128i idx) {
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), cost, idx, all, 8);
+}
+
+__attribute__((target("avx2")))
+static inline __m256d gatherCosts4(const int32_t* cost, __m128i idx) {
+    __m128i values = _mm_mask_i32gather_epi32(_mm_setzero_si128(), cost, idx, _mm_set1_epi32(-1), 4);
+    return _mm256_cvtepi32_pd(values);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d gatherCosts8(const double* cost, __m256i idx) {
+    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, cost, 8);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d gatherCosts8(const int32_t* cost, __m256i idx) {
+    __m256i values = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), cost, idx, _mm256_set1_epi32(-1), 4);
+    return _mm512_maskz_cvtepi32_pd(0xFF, values);
+}
+
+template <typename Cost>
+__attribute__((target("avx2")))
+static size_t accumulateAVX2(const BatchEvaluator& be, const Cost* cost, size_t count, size_t stride, double* out) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    size_t c = 0;
+    for (; c + 4 <= count; c += 4) {
+        __m256d added_sum = _mm256_setzero_pd();
+        __m256d removed_sum = _mm256_setzero_pd();
+        for (int k = 0; k < MOVE_SLOTS; ++k) {
+            __m128i add_idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&be.added[k * stride + c]));
+            __m128i rem_idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&be.removed[k * stride + c]));
+            added_sum = _mm256_add_pd(added_sum, gatherCosts4(cost, add_idx));
+            removed_sum = _mm256_add_pd(removed_sum, _mm256_mask_i32gather_pd(zero, be.removed_cost.data(), rem_idx, all, 8));
+        }
+        _mm256_storeu_pd(out + c, _mm256_sub_pd(added_sum, removed_sum));
+    }
+    return c;
+}
+
+template <typename Cost>
+__attribute__((target("avx512f")))
+static size_t accumulateAVX512(const BatchEvaluator& be, const Cost* cost, size_t count, size_t stride, double* out) {
+    const __m512d zero = _mm512_setzero_pd();
+    size_t c = 0;
+    for (; c + 8 <= count; c += 8) {
+        __m512d added_sum = _mm512_setzero_pd();
+        __m512d removed_sum = _mm512_setzero_pd();
+        for (int k = 0; k < MOVE_SLOTS; ++k) {
+            __m256i add_idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&be.added[k * stride + c]));
+            __m256i rem_idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&be.removed[k * stride + c]));
+            added_sum = _mm512_add_pd(added_sum, gatherCosts8(cost, add_idx));
+            removed_sum = _mm512_add_pd(removed_sum, _mm512_mask_i32gather_pd(zero, 0xFF, rem_idx, be.removed_cost.data(), 8));
+        }
+        _mm512_storeu_pd(out + c, _mm512_sub_pd(added_sum, removed_sum));
+    }
+    return c;
+}
+
+#endif
+
+// plain deltas of candidates [0, count), using the widest instruction set available
+template <typename Cost>
+static void accumulateDeltas(const BatchEvaluator& be, const Cost* cost, size_t count, size_t stride, double* out) {
+
+    size_t done = 0;
+
+#ifdef TATSP_X86_SIMD
+    static const bool has_avx512 = __builtin_cpu_supports("avx512f");
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+
+    if (has_avx512)
+        done = accumulateAVX512(be, cost, count, stride, out);
+    else if (has_avx2)
+        done = accumulateAVX2(be, cost, count, stride, out);
+#endif
+
+    accumulateScalar(be, cost, done, count, stride, out);
+}
+
+void evaluateMoves(BatchEvaluator& be, Graph& graph, vector<CandidateMove>& moves) {
+
+    size_t count = moves.size();
+    if (count == 0)
+        return;
+
+    size_t stride = count;
+    be.added.resize(MOVE_SLOTS * stride);
+    be.removed.resize(MOVE_SLOTS * stride);
+    be.exact.clear();
+    be.missing.clear();
+
+    vector<double> deltas(count);
+    visitCompactInstance(graph, [&](const auto& instance) {
+        for (size_t c = 0; c < count; ++c) {
+            SlotKind kind = buildSlots(be, instance, moves[c], c, stride);
+            if (kind == SlotKind::EXACT)
+                be.exact.push_back(c);
+            else if (kind == SlotKind::MISSING)
+                be.missing.push_back(c);
+        }
+        accumulateDeltas(be, instance.original_cost.data(), count, stride, deltas.data());
+    });
+    for (size_t c = 0; c < count; ++c)
+        moves[c].delta = deltas[c];
+    for (int c : be.missing)
+        moves[c].delta = numeric_limits<double>::infinity();
+
+    // candidates touching a trigger or a target arc are re-priced exactly
+    vector<int> new_nodes;
+    for (int c : be.exact) {
+        CandidateMove& move = moves[c];
+        if (move.type == MoveType::SWAP)
+            swapSegment(be.ev, min(move.i, move.j), max(move.i, move.j), new_nodes);
+        else
+            relocateSegment(be.ev, move.i, move.j, new_nodes);
+        move.delta = evaluateSegmentDelta(be.ev, graph, min(move.i, move.j), max(move.i, move.j), new_nodes);
+    }
+}
+
+int selectBestMove(const vector<CandidateMove>& moves) {
+
+    // ties are broken by position so the result does not depend on the candidate order
+    int best = -1;
+    for (size_t c = 0; c < moves.size(); ++c) {
+        const CandidateMove& a = moves[c];
+        if (best == -1 || a.delta < moves[best].delta ||
+            (a.delta == moves[best].delta && make_pair(a.i, a.j) < make_pair(moves[best].i, moves[best].j)))
+            best = c;
+    }
+    return best;
+}
@@ -0,0 +1,184 @@
+#include "benchmark.hpp"
+#include "diagnostics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+int runBenchmark(const Graph& graph, const vector<Arc>& all_arcs, const SolverConfig& config,
+                 const BenchmarkConfig& bench, BenchmarkResult& result) {
+
+    if (bench.runs <= 0 || bench.threads < 0) {
+        diagnostics() << "Error: Benchmark runs must be positive and threads non-negative." << endl;
+        return -1;
+    }
+    if (!config.checkpoint_file.empty() || !config.island_name.empty()) {
+        diagnostics() << "Error: Checkpoints and islands can not be used in benchmark mode." << endl;
+        return -1;
+    }
+
+    int hardware_threads = max(1u, thread::hardware_concurrency());
+    int threads = bench.threads;
+    if (threads == 0)
+        threads = hardware_threads;
+    threads = min(threads, bench.runs);
+
+    result.runs.assign(bench.runs, BenchmarkRun());
+
+    atomic<int> next_run(0);
+    atomic<bool> invalid(false);
+
+    // each worker takes the next pending run until none is left
+    auto worker = [&]() {
+        for (int r = next_run++; r < bench.runs; r = next_run++) {
+            BenchmarkRun& run = result.runs[r];
+            run.seed = bench.base_seed + r;
+            run.time_to_target.assign(bench.targets.size(), numeric_limits<double>::infinity());
+
+            SolverConfig run_config = config;
+            run_config.seed = run.seed;
+            run_config.verbose = false;
+            // the concurrent runs share the hardware threads instead of each relinking on all of them
+            if (run_config.pr_threads == 0)
+                run_config.pr_threads = max(1, hardware_threads / threads);
+
+            auto on_improvement = [&](const Tour& tour, int, double elapsed) {
+                for (size_t t = 0; t < bench.targets.size(); ++t)
+                    if (tour.tour_cost <= bench.targets[t] && run.time_to_target[t] == numeric_limits<double>::infinity())
+                        run.time_to_target[t] = elapsed;
+            };
+
+            SolverResult solver_result;
+            if (solveTATSP(graph, all_arcs, run_config, solver_result, on_improvement) == -1) {
+                invalid = true;
+                return;
+            }
+
+            if (!solver_result.best_tour.tour.empty())
+                run.best_cost = solver_result.best_tour.tour_cost;
+            run.iterations = solver_result.stats.iterations;
+            run.elapsed = solver_result.stats.elapsed;
+        }
+    };
+
+    vector<thread> pool;
+    for (int k = 0; k < threads; ++k)
+        pool.emplace_back(worker);
+    for (thread& t : pool)
+        t.join();
+
+    return invalid ? -1 : 0;
+}
+
+static double median(vector<double> values) {
+    if (values.empty())
+        return numeric_limits<double>::infinity();
+    sort(values.begin(), values.end());
+    size_t m = values.size() / 2;
+    return (values.size() % 2) ? values[m] : 0.5 * (values[m - 1] + values[m]);
+}
+
+// empirical TTT probability of each run for target t, 0 for the runs that missed it
+static vector<double> tttProbabilities(const BenchmarkResult& result, size_t t) {
+
+    size_t R = result.runs.size();
+    vector<size_t> order;
+    for (size_t r = 0; r < R; ++r)
+        if (result.runs[r].time_to_target[t] != numeric_limits<double>::infinity())
+            order.push_back(r);
+
+    // ties keep the run order, so the output does not depend on the sort implementation
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return result.runs[a].time_to_target[t] < result.runs[b].time_to_target[t];
+    });
+
+    vector<double> probability(R, 0.0);
+    for (size_t k = 0; k < order.size(); ++k)
+        probability[order[k]] = (k + 0.5) / R;
+    return probability;
+}
+
+void writeBenchmarkCSV(ostream& out, const BenchmarkConfig& bench, const BenchmarkResult& result) {
+
+    out << "run,seed,best_cost,iterations,elapsed,iterations_per_second,target,time_to_target,ttt_probability\n";
+
+    vector<vector<double>> probability;
+    for (size_t t = 0; t < bench.targets.size(); ++t)
+        probability.push_back(tttProbabilities(result, t));
+
+    for (size_t r = 0; r < result.runs.size(); ++r) {
+        const BenchmarkRun& run = result.runs[r];
+        double rate = (run.elapsed > 0) ? run.iterations / run.elapsed : 0.0;
+
+        auto prefix = [&]() {
+            out << r << "," << run.seed << ",";
+            if (run.best_cost != numeric_limits<double>::infinity())
+                out << run.best_cost;
+            out << "," << run.iterations << "," << run.elapsed << "," << rate << ",";
+        };
+
+        // empty fields: no tour found, target not reached
+        if (bench.targets.empty()) {
+            prefix();
+            out << ",,\n";
+            continue;
+        }
+
+        for (size_t t = 0; t < bench.targets.size(); ++t) {
+            prefix();
+            out << bench.targets[t] << ",";
+            if (run.time_to_target[t] != numeric_limits<double>::infinity())
+                out << run.time_to_target[t] << "," << probability[t][r];
+            else
+                out << ",";
+            out << "\n";
+        }
+    }
+}
+
+void printBenchmarkSummary(const BenchmarkConfig& bench, const BenchmarkResult& result) {
+
+    vector<double> costs, rates;
+    for (const BenchmarkRun& run : result.runs) {
+        if (run.best_cost != numeric_limits<double>::infinity())
+            costs.push_back(run.best_cost);
+        if (run.elapsed > 0)
+            rates.push_back(run.iterations / run.elapsed);
+    }
+
+    size_t R = result.runs.size();
+    cout << "Benchmark: " << R << " runs, " << costs.size() << " with a feasible tour" << endl;
+
+    if (!costs.empty()) {
+        double mean = 0;
+        for (double c : costs)
+            mean += c;
+        mean /= costs.size();
+        cout << "Best Cost: " << *min_element(costs.begin(), costs.end())
+             << ", Mean Cost: " << mean << ", Median Cost: " << median(costs) << endl;
+    }
+
+    if (!rates.empty()) {
+        double mean_rate = 0;
+        for (double rate : rates)
+            mean_rate += rate;
+        cout << "Iterations per Second: " << mean_rate / rates.size() << " (mean over runs)" << endl;
+    }
+
+    for (size_t t = 0; t < bench.targets.size(); ++t) {
+        vector<double> times;
+        for (const BenchmarkRun& run : result.runs)
+            if (run.time_to_target[t] != numeric_limits<double>::infinity())
+                times.push_back(run.time_to_target[t]);
+
+        cout << "Target " << bench.targets[t] << ": reached by " << times.size() << "/" << R;
+        if (!times.empty()) {
+            double mean = 0;
+            for (double time : times)
+                mean += time;
+            cout << ", Mean Time: " << mean / times.size() << "s, Median Time: " << median(times) << "s";
+        }
+        cout << endl;
+    }
+}
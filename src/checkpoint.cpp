@@ -0,0 +1,177 @@
+#include "checkpoint.hpp"
+#include "construction.hpp"
+#include "local_search.hpp"
+#include "diagnostics.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+static void writeTourLine(ostream& out, Tour& tour) {
+    size_t n = tour.tour.size();
+    out << tour.tour_cost;
+    for (size_t i = 0; i < n; ++i)
+        out << " " << tour.tour[i];
+    out << "\n";
+}
+
+static bool readTourLine(istream& in, size_t n, Tour& tour) {
+    tour.tour.assign(n, 0);
+    if (!(in >> tour.tour_cost))
+        return false;
+    for (size_t i = 0; i < n; ++i)
+        if (!(in >> tour.tour[i]))
+            return false;
+    return true;
+}
+
+bool writeCheckpoint(const string& filename, Tour& best_tour, vector<Tour>& pool, const vector<mt19937*>& rngs) {
+
+    string tmp_filename = filename + ".tmp";
+    ofstream out(tmp_filename);
+    if (!out.is_open()) {
+        diagnostics() << "Error: Cannot write checkpoint file '" << tmp_filename << "'." << endl;
+        return false;
+    }
+
+    out.precision(numeric_limits<double>::max_digits10);
+
+    out << CHECKPOINT_HEADER << " " << CHECKPOINT_VERSION << "\n";
+    out << best_tour.tour.size() << " " << pool.size() << " " << rngs.size() << "\n";
+
+    writeTourLine(out, best_tour);
+    for (Tour& tour : pool)
+        writeTourLine(out, tour);
+    for (mt19937* rng : rngs)
+        out << *rng << "\n";
+
+    out.close();
+    if (!out) {
+        diagnostics() << "Error: Failed while writing checkpoint file '" << tmp_filename << "'." << endl;
+        return false;
+    }
+
+    if (rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        diagnostics() << "Error: Cannot move checkpoint to '" << filename << "'." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool readCheckpoint(const string& filename, Graph& graph, Tour& best_tour, vector<Tour>& pool,
+                    const vector<mt19937*>& rngs) {
+
+    ifstream in(filename);
+    if (!in.is_open()) {
+        diagnostics() << "Error: Cannot open checkpoint file '" << filename << "'." << endl;
+        return false;
+    }
+
+    string header;
+    int version;
+    size_t n, pool_size, num_rngs;
+
+    in >> header >> version >> n >> pool_size >> num_rngs;
+    if (!in || header != CHECKPOINT_HEADER || version != CHECKPOINT_VERSION) {
+        diagnostics() << "Error: '" << filename << "' is not a valid checkpoint file." << endl;
+        return false;
+    }
+
+    if (n != graph.adj.size()) {
+        diagnostics() << "Error: Checkpoint has tours of " << n << " nodes, the instance has "
+             << graph.adj.size() << "." << endl;
+        return false;
+    }
+
+    Tour tour;
+    if (!readTourLine(in, n, tour)) {
+        diagnostics() << "Error: Truncated checkpoint file '" << filename << "'." << endl;
+        return false;
+    }
+    if (validateTour(tour, graph))
+        best_tour = tour;
+    else
+        diagnostics() << "Warning: Checkpoint best tour is infeasible for this instance, ignoring it." << endl;
+
+    pool.clear();
+    for (size_t k = 0; k < pool_size; ++k) {
+        if (!readTourLine(in, n, tour)) {
+            diagnostics() << "Error: Truncated checkpoint file '" << filename << "'." << endl;
+            return false;
+        }
+        if (validateTour(tour, graph)) {
+            pool.push_back(tour);
+            if (best_tour.tour.empty() || tour.tour_cost < best_tour.tour_cost)
+                best_tour = tour;
+        }
+    }
+
+    if (num_rngs == rngs.size()) {
+        for (mt19937* rng : rngs)
+            in >> *rng;
+        if (!in) {
+            diagnostics() << "Error: Truncated checkpoint file '" << filename << "'." << endl;
+            return false;
+        }
+    }
+    else {
+        diagnostics() << "Warning: Checkpoint has " << num_rngs << " random generators, expected "
+             << rngs.size() << "; keeping fresh seeds." << endl;
+    }
+
+    return !best_tour.tour.empty();
+}
+
+bool readTourFile(const string& filename, Graph& graph, Tour& tour) {
+
+    ifstream in(filename);
+    if (!in.is_open()) {
+        diagnostics() << "Error: Cannot open tour file '" << filename << "'." << endl;
+        return false;
+    }
+
+    stringstream buffer;
+    buffer << in.rdbuf();
+    string text = buffer.str();
+
+    // anything that is not a digit separates two node ids
+    replace_if(text.begin(), text.end(), [](char c) { return c < '0' || c > '9'; }, ' ');
+
+    istringstream nodes(text);
+    tour.tour.clear();
+    int node;
+    while (nodes >> node)
+        tour.tour.push_back(node);
+
+    if (!validateTour(tour, graph)) {
+        diagnostics() << "Error: Tour in '" << filename << "' is not a feasible tour of this instance." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool validateTour(Tour& tour, Graph& graph) {
+
+    size_t n = graph.adj.size();
+    if (tour.tour.size() != n)
+        return false;
+
+    vector<bool> seen(n, false);
+    for (int node : tour.tour) {
+        if (node < 0 || (size_t)node >= n || seen[node])
+            return false;
+        seen[node] = true;
+    }
+
+    anchorTour(tour);
+
+    if (!checkTourFeasibility(tour, graph))
+        return false;
+
+    calculateTATSPcost(tour, graph);
+    return true;
+}
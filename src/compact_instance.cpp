@@ -0,0 +1,248 @@
+#include "compact_instance.hpp"
+
+#include <atomic>
+#include <cmath>
+
+template <typename ArcId, typename Cost>
+bool CompactInstance<ArcId, Cost>::tourCost(const vector<int>& t, double cutoff, double& cost) const {
+
+    size_t n = adj.size();
+    if (t.empty() || t.size() != n) {
+        cost = numeric_limits<double>::infinity();
+        return false;
+    }
+
+    // trigger-adjusted arc costs of this thread, back to original_cost after every call
+    static thread_local vector<Cost> current;
+    static thread_local uint64_t current_id = 0;
+    if (current_id != id) {
+        current = original_cost;
+        current_id = id;
+    }
+
+    // an infinite cutoff (calculateTATSPcost) never stops the walk, the bound is not needed
+    bool bounded = cutoff != numeric_limits<double>::infinity();
+    Sum remaining_bound = min_out_total;
+
+    Sum total_cost = 0;
+    size_t steps = 0;
+
+    auto arc_at = [&](size_t k) { return adj.arc(t[k], t[k + 1 == n ? 0 : k + 1]); };
+
+    while (steps < n) {
+        int a = arc_at(steps);
+        if (a == -1)
+            break;
+
+        total_cost += current[a];
+        if (bounded)
+            remaining_bound -= min_out_cost[t[steps]];
+
+        for (uint32_t r = target_begin[a]; r < target_begin[a + 1]; ++r)
+            current[targets[r].arc] = targets[r].cost;
+
+        steps++;
+
+        if (bounded && (double)(total_cost + remaining_bound) >= cutoff)
+            break;
+    }
+
+    for (size_t k = 0; k < steps; ++k) {
+        int a = arc_at(k);
+        for (uint32_t r = target_begin[a]; r < target_begin[a + 1]; ++r)
+            current[targets[r].arc] = original_cost[targets[r].arc];
+    }
+
+    if (steps < n) {
+        cost = numeric_limits<double>::infinity();
+        return false;
+    }
+
+    cost = (double)total_cost;
+    return cost < cutoff;
+}
+
+template <typename ArcId, typename Cost>
+size_t CompactInstance<ArcId, Cost>::footprint() const {
+    size_t n = adj.size();
+    size_t node_bytes = adj.wide ? sizeof(uint32_t) : sizeof(uint16_t);
+    size_t adj_bytes = n * n * node_bytes + num_arcs * node_bytes + (n + 1) * sizeof(int);
+    return adj_bytes + original_cost.size() * sizeof(Cost) +
+           (target_begin.size() + trigger_begin.size()) * sizeof(uint32_t) +
+           (targets.size() + triggers.size()) * sizeof(Relation) + min_out_cost.size() * sizeof(Cost);
+}
+
+template struct CompactInstance<uint16_t, int32_t>;
+template struct CompactInstance<uint16_t, double>;
+template struct CompactInstance<uint32_t, int32_t>;
+template struct CompactInstance<uint32_t, double>;
+
+static bool fitsInt32(double c) {
+    return c == floor(c) && fabs(c) <= numeric_limits<int32_t>::max();
+}
+
+CompactLayout chooseCompactLayout(int num_nodes, const vector<Arc>& all_arcs) {
+
+    CompactLayout layout;
+
+    // the largest value of the index type marks a missing arc
+    vector<int> out_degree(num_nodes, 0);
+    int max_out_degree = 0;
+    for (const Arc& arc : all_arcs)
+        max_out_degree = max(max_out_degree, ++out_degree[arc.from]);
+    bool narrow_nodes = num_nodes < numeric_limits<uint16_t>::max() && max_out_degree < numeric_limits<uint16_t>::max();
+    layout.node = narrow_nodes ? IndexWidth::U16 : IndexWidth::U32;
+
+    layout.arc = (all_arcs.size() < numeric_limits<uint16_t>::max()) ? IndexWidth::U16 : IndexWidth::U32;
+
+    // min_out_cost is a minimum over these costs (or 0), so it is integral too
+    layout.cost = CostKind::INT32;
+    for (const Arc& arc : all_arcs) {
+        bool integral = fitsInt32(arc.original_cost);
+        for (auto& [target_idx, target_cost] : arc.targets)
+            integral = integral && fitsInt32(target_cost);
+        if (!integral) {
+            layout.cost = CostKind::DOUBLE;
+            break;
+        }
+    }
+
+    return layout;
+}
+
+struct ArcMatrixStorage {
+    vector<int> first_out;
+    vector<uint16_t> ranks16, tails16;
+    vector<uint32_t> ranks32, tails32;
+};
+
+template <typename Node>
+static void fillArcMatrix(int n, const vector<Arc>& all_arcs, const vector<int>& first_out,
+                          vector<Node>& ranks, vector<Node>& tails) {
+
+    ranks.assign((size_t)n * n, numeric_limits<Node>::max());
+    tails.resize(all_arcs.size());
+
+    // arcs are sorted by tail, so the rank is the offset from the first arc of the tail;
+    // of two parallel arcs the later one is kept, as a plain n x n array would do
+    for (size_t k = 0; k < all_arcs.size(); ++k) {
+        const Arc& arc = all_arcs[k];
+        ranks[(size_t)arc.from * n + arc.to] = (Node)(k - first_out[arc.from]);
+        tails[k] = (Node)arc.from;
+    }
+}
+
+static ArcMatrix buildArcMatrix(int n, const vector<Arc>& all_arcs, bool wide) {
+
+    auto storage = make_shared<ArcMatrixStorage>();
+
+    storage->first_out.assign(n + 1, 0);
+    for (const Arc& arc : all_arcs)
+        storage->first_out[arc.from + 1]++;
+    for (int u = 0; u < n; ++u)
+        storage->first_out[u + 1] += storage->first_out[u];
+
+    ArcMatrix adj;
+    adj.n = n;
+    adj.wide = wide;
+    adj.first_out = storage->first_out.data();
+
+    if (wide) {
+        fillArcMatrix(n, all_arcs, storage->first_out, storage->ranks32, storage->tails32);
+        adj.ranks32 = storage->ranks32.data();
+        adj.tails32 = storage->tails32.data();
+    }
+    else {
+        fillArcMatrix(n, all_arcs, storage->first_out, storage->ranks16, storage->tails16);
+        adj.ranks16 = storage->ranks16.data();
+        adj.tails16 = storage->tails16.data();
+    }
+
+    adj.storage = storage;
+    return adj;
+}
+
+template <typename ArcId, typename Cost>
+static shared_ptr<const CompactInstanceBase> buildCompact(int n, const vector<Arc>& all_arcs, const ArcMatrix& adj,
+                                                          CompactLayout layout) {
+
+    static atomic<uint64_t> next_id{1};
+
+    using Instance = CompactInstance<ArcId, Cost>;
+    auto compact = make_shared<Instance>();
+    compact->layout = layout;
+    compact->id = next_id++;
+    compact->adj = adj;
+
+    size_t num_arcs = all_arcs.size();
+    compact->num_arcs = num_arcs;
+
+    compact->original_cost.resize(num_arcs + 1);
+    compact->target_begin.assign(num_arcs + 1, 0);
+    compact->trigger_begin.assign(num_arcs + 2, 0);
+    for (size_t k = 0; k < num_arcs; ++k) {
+        compact->original_cost[k] = (Cost)all_arcs[k].original_cost;
+        compact->target_begin[k] = compact->targets.size();
+        for (auto& [target_idx, target_cost] : all_arcs[k].targets) {
+            compact->targets.push_back({(ArcId)target_idx, (Cost)target_cost});
+            compact->trigger_begin[target_idx + 2]++;
+        }
+    }
+    compact->original_cost[num_arcs] = 0;
+    compact->target_begin[num_arcs] = compact->targets.size();
+
+    // counting sort of the relations by target, triggers in increasing order
+    for (size_t k = 2; k < num_arcs + 2; ++k)
+        compact->trigger_begin[k] += compact->trigger_begin[k - 1];
+    compact->triggers.resize(compact->targets.size());
+    for (size_t k = 0; k < num_arcs; ++k)
+        for (auto& [target_idx, target_cost] : all_arcs[k].targets)
+            compact->triggers[compact->trigger_begin[target_idx + 1]++] = {(ArcId)k, (Cost)target_cost};
+    compact->trigger_begin.pop_back();
+
+    // lower bound of calculateTATSPcostBounded: an arc never costs less than its cheapest trigger
+    vector<Cost> min_cost(compact->original_cost.begin(), compact->original_cost.end() - 1);
+    for (const auto& relation : compact->targets)
+        min_cost[relation.arc] = min(min_cost[relation.arc], relation.cost);
+
+    vector<bool> has_out(n, false);
+    compact->min_out_cost.assign(n, 0);
+    for (size_t k = 0; k < num_arcs; ++k) {
+        int u = all_arcs[k].from;
+        if (u == all_arcs[k].to && n != 1)
+            continue;
+        if (!has_out[u] || min_cost[k] < compact->min_out_cost[u])
+            compact->min_out_cost[u] = min_cost[k];
+        has_out[u] = true;
+    }
+
+    compact->min_out_total = 0;
+    for (int u = 0; u < n; ++u)
+        compact->min_out_total += compact->min_out_cost[u];
+
+    return compact;
+}
+
+void buildCompactInstance(int num_nodes, const vector<Arc>& all_arcs, Graph& graph) {
+
+    CompactLayout layout = chooseCompactLayout(num_nodes, all_arcs);
+
+    graph.adj = buildArcMatrix(num_nodes, all_arcs, layout.node == IndexWidth::U32);
+
+    if (layout.arc == IndexWidth::U16)
+        graph.compact = (layout.cost == CostKind::INT32) ? buildCompact<uint16_t, int32_t>(num_nodes, all_arcs, graph.adj, layout)
+                                                         : buildCompact<uint16_t, double>(num_nodes, all_arcs, graph.adj, layout);
+    else
+        graph.compact = (layout.cost == CostKind::INT32) ? buildCompact<uint32_t, int32_t>(num_nodes, all_arcs, graph.adj, layout)
+                                                         : buildCompact<uint32_t, double>(num_nodes, all_arcs, graph.adj, layout);
+}
+
+string describeCompactLayout(const CompactInstanceBase& compact) {
+
+    string node = (compact.layout.node == IndexWidth::U16) ? "16-bit" : "32-bit";
+    string arc = (compact.layout.arc == IndexWidth::U16) ? "16-bit" : "32-bit";
+    string cost = (compact.layout.cost == CostKind::INT32) ? "int32" : "double";
+
+    return node + " node ranks, " + arc + " arc ids, " + cost + " costs, " +
+           to_string((compact.footprint() + 1023) / 1024) + " KB";
+}
@@ -1,4 +1,8 @@
 #include "construction.hpp"
+#include "compact_instance.hpp"
+#include "diagnostics.hpp"
+
+#include <algorithm>
 
 void additivePerturbation(vector<Arc>& all_arcs, double alpha, mt19937& gen){
     uniform_real_distribution<> dist(-1.0, 1.0);
@@ -21,7 +25,7 @@ int solveTSP(const Graph& graph, const vector<Arc>& all_arcs, Tour& solution_tou
     // Get the number of nodes
     int n = graph.adj.size();
     if (n == 0) {
-        cerr << "Error: Graph is empty." << endl;
+        diagnostics() << "Error: Graph is empty." << endl;
         return -1;
     }
 
@@ -77,7 +81,8 @@ int solveTSP(const Graph& graph, const vector<Arc>& all_arcs, Tour& solution_tou
         // --- 3. Add Constraints ---
         for (int i = 0; i < n; ++i) {
             GRBLinExpr expr = 0;
-            for (int k : graph.adj[i]) {
+            for (int j = 0; j < n; ++j) {
+                int k = graph.adj[i][j];
                 if (k != -1) 
                     expr += x[k];
             }
@@ -129,10 +134,11 @@ int solveTSP(const Graph& graph, const vector<Arc>& all_arcs, Tour& solution_tou
                 solution_tour.tour.push_back(current_node);
                 current_node = successor[current_node];
             }
+            anchorTour(solution_tour);
 
         } else {
             // This now means no feasible solution was found in the time limit
-            // cerr << "No feasible solution found by Gurobi. Status: "
+            // diagnostics() << "No feasible solution found by Gurobi. Status: "
             //      << model.get(GRB_IntAttr_Status) << endl;
             
             // We no longer print an error, just return -1 to signal failure
@@ -140,11 +146,11 @@ int solveTSP(const Graph& graph, const vector<Arc>& all_arcs, Tour& solution_tou
         }
 
     } catch (GRBException e) {
-        cerr << "Gurobi Error code = " << e.getErrorCode() << endl;
-        cerr << e.getMessage() << endl;
+        diagnostics() << "Gurobi Error code = " << e.getErrorCode() << endl;
+        diagnostics() << e.getMessage() << endl;
         return -1;
     } catch (...) {
-        cerr << "An unknown error occurred." << endl;
+        diagnostics() << "An unknown error occurred." << endl;
         return -1;
     }
 
@@ -178,55 +184,36 @@ int constructiveHeuristic(Graph& graph, vector<Arc>& all_arcs, Tour& solution_to
     }
 
     // If solve succeeded, calculate the cost and return 0
-    calculateTATSPcost(solution_tour, all_arcs, graph);
+    calculateTATSPcost(solution_tour, graph);
     
     return 0; // Signal success
 }
 
-void calculateTATSPcost(Tour& solution_tour, vector<Arc>& all_arcs, Graph& graph){
-
-    double total_cost = 0;
-
-    size_t n = solution_tour.tour.size();
-
-    // Check for an empty tour, which might happen if Gurobi fails
-    // and the check in constructiveHeuristic was missed. This is a safeguard.
-    if (n == 0) {
-        solution_tour.tour_cost = numeric_limits<double>::infinity();
-        return;
-    }
-
-    int i = solution_tour.depot_idx;
-   
-    do {
+void calculateTATSPcost(Tour& solution_tour, Graph& graph){
 
-        int from = solution_tour.tour[i]; int to = solution_tour.tour[(i+1) % n];
-        int arc_idx = graph.adj[from][to];
+    // an empty tour (failed construction) or one using a missing arc costs infinity
+    graph.compact->tourCost(solution_tour.tour, numeric_limits<double>::infinity(), solution_tour.tour_cost);
 
+}
 
-        Arc current_arc = all_arcs[arc_idx];
-
-
-
-        total_cost += current_arc.current_cost;
-
-        for (auto& [target_idx, target_cost]: current_arc.targets)
-            all_arcs[target_idx].current_cost = target_cost;
-
-        i = (i + 1) % n;
+int modified_mod(int a, int b) {
+    int r = a % b;
+    if (r < 0) r += b;
+    return r;
+}
 
+bool calculateTATSPcostBounded(Tour& solution_tour, Graph& graph, double cutoff){
 
-    }  while (solution_tour.tour[i] != 0);
+    return graph.compact->tourCost(solution_tour.tour, cutoff, solution_tour.tour_cost);
+}
 
-    for (Arc& arc: all_arcs)
-            arc.current_cost = arc.original_cost;
+void anchorTour(Tour& tour) {
 
-    solution_tour.tour_cost = total_cost;
+    vector<int>& t = tour.tour;
+    if (!t.empty() && t[0] != 0)
+        rotate(t.begin(), find(t.begin(), t.end(), 0), t.end());
 
+    tour.pos.resize(t.size());
+    for (size_t i = 0; i < t.size(); ++i)
+        tour.pos[t[i]] = i;
 }
-
-int modified_mod(int a, int b) {
-    int r = a % b;
-    if (r < 0) r += b;
-    return r;
-}
\ No newline at end of file
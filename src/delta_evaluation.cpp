@@ -0,0 +1,172 @@
+#include "delta_evaluation.hpp"
+#include "compact_instance.hpp"
+
+#include <algorithm>
+#include <limits>
+
+// cost of arc b when it is traversed at position p, given the position of its triggers
+template <typename Instance, typename PositionOf>
+static double triggeredCost(const Instance& instance, int b, int p, PositionOf position_of) {
+
+    // the last trigger traversed before p sets the cost (same rule as calculateTATSPcost)
+    int best_pos = -1;
+    double cost = instance.original_cost[b];
+
+    for (uint32_t r = instance.trigger_begin[b]; r < instance.trigger_begin[b + 1]; ++r) {
+        int pos = position_of(instance.triggers[r].arc);
+        if (pos != -1 && pos < p && pos >= best_pos) {
+            best_pos = pos;
+            cost = instance.triggers[r].cost;
+        }
+    }
+
+    return cost;
+}
+
+int arcPosition(const DeltaEvaluator& ev, const Graph& graph, int a) {
+    // the only arc of the tour leaving the tail of a is arc_at[pos[tail]]
+    int k = ev.pos[graph.adj.tail(a)];
+    return (ev.arc_at[k] == a) ? k : -1;
+}
+
+bool initDeltaEvaluator(DeltaEvaluator& ev, Tour& tour, Graph& graph) {
+
+    size_t n = tour.tour.size();
+
+    ev.seq = tour.tour;
+
+    for (size_t k = 0; k < n; ++k) {
+        if (graph.adj[ev.seq[k]][ev.seq[(k + 1) % n]] == -1) {
+            ev.seq.clear();
+            return false;
+        }
+    }
+
+    ev.pos.resize(n);
+    ev.new_pos.resize(n);
+    ev.new_stamp.assign(n, 0);
+    ev.seen_stamp.assign(n, 0);
+    ev.stamp = 0;
+
+    rebuildDeltaEvaluator(ev, graph);
+    return true;
+}
+
+void rebuildDeltaEvaluator(DeltaEvaluator& ev, Graph& graph) {
+
+    size_t n = ev.seq.size();
+
+    ev.arc_at.resize(n);
+    ev.cost_at.resize(n);
+
+    for (size_t k = 0; k < n; ++k) {
+        ev.pos[ev.seq[k]] = k;
+        ev.arc_at[k] = graph.adj[ev.seq[k]][ev.seq[(k + 1) % n]];
+    }
+
+    visitCompactInstance(graph, [&](const auto& instance) {
+        ev.tour_cost = 0;
+        for (size_t k = 0; k < n; ++k) {
+            ev.cost_at[k] = triggeredCost(instance, ev.arc_at[k], k, [&](int a) { return arcPosition(ev, graph, a); });
+            ev.tour_cost += ev.cost_at[k];
+        }
+    });
+}
+
+template <typename Instance>
+static double segmentDelta(DeltaEvaluator& ev, Graph& graph, const Instance& instance,
+                           int first, int last, const vector<int>& new_nodes) {
+
+    int n = ev.seq.size();
+    int L = first - 1; // first arc that changes (enters the segment)
+    int R = last;      // last arc that changes (leaves the segment)
+
+    int stamp = ++ev.stamp;
+    ev.new_arcs.resize(R - L + 1);
+
+    for (int k = L; k <= R; ++k) {
+        int from = (k == L) ? ev.seq[L] : new_nodes[k - first];
+        int to = (k == R) ? ev.seq[(R + 1) % n] : new_nodes[k + 1 - first];
+        int a = graph.adj[from][to];
+        if (a == -1)
+            return numeric_limits<double>::infinity();
+        ev.new_arcs[k - L] = a;
+        ev.new_pos[from] = k;
+        ev.new_stamp[from] = stamp;
+    }
+
+    // positions in the candidate tour: the nodes at [L, R] leave through the new arcs,
+    // every other node keeps its outgoing arc and its position
+    auto position_of = [&](int a) {
+        int u = graph.adj.tail(a);
+        if (ev.new_stamp[u] == stamp) {
+            int k = ev.new_pos[u];
+            return (ev.new_arcs[k - L] == a) ? k : -1;
+        }
+        return arcPosition(ev, graph, a);
+    };
+
+    double delta = 0;
+
+    for (int k = L; k <= R; ++k)
+        delta += triggeredCost(instance, ev.new_arcs[k - L], k, position_of) - ev.cost_at[k];
+
+    // arcs after the segment only change if one of their triggers entered or left it
+    auto reprice_targets = [&](int a) {
+        for (uint32_t r = instance.target_begin[a]; r < instance.target_begin[a + 1]; ++r) {
+            int target = instance.targets[r].arc;
+            int p = arcPosition(ev, graph, target);
+            if (p <= R || ev.seen_stamp[p] == stamp)
+                continue;
+            ev.seen_stamp[p] = stamp;
+            delta += triggeredCost(instance, target, p, position_of) - ev.cost_at[p];
+        }
+    };
+
+    for (int k = L; k <= R; ++k) {
+        reprice_targets(ev.arc_at[k]);
+        reprice_targets(ev.new_arcs[k - L]);
+    }
+
+    return delta;
+}
+
+double evaluateSegmentDelta(DeltaEvaluator& ev, Graph& graph, int first, int last, const vector<int>& new_nodes) {
+    return visitCompactInstance(graph, [&](const auto& instance) {
+        return segmentDelta(ev, graph, instance, first, last, new_nodes);
+    });
+}
+
+void commitSegment(DeltaEvaluator& ev, Graph& graph, int first, const vector<int>& new_nodes) {
+
+    copy(new_nodes.begin(), new_nodes.end(), ev.seq.begin() + first);
+    rebuildDeltaEvaluator(ev, graph);
+}
+
+void swapSegment(DeltaEvaluator& ev, int i, int j, vector<int>& new_nodes) {
+    new_nodes.assign(ev.seq.begin() + i, ev.seq.begin() + j + 1);
+    swap(new_nodes.front(), new_nodes.back());
+}
+
+void relocateSegment(DeltaEvaluator& ev, int from, int to, vector<int>& new_nodes) {
+    if (from < to) {
+        new_nodes.assign(ev.seq.begin() + from + 1, ev.seq.begin() + to + 1);
+        new_nodes.push_back(ev.seq[from]);
+    }
+    else {
+        new_nodes.assign(1, ev.seq[from]);
+        new_nodes.insert(new_nodes.end(), ev.seq.begin() + to, ev.seq.begin() + from);
+    }
+}
+
+void reverseSegment(DeltaEvaluator& ev, int i, int j, vector<int>& new_nodes) {
+    new_nodes.assign(ev.seq.rend() - j - 1, ev.seq.rend() - i);
+}
+
+Tour evaluatorTour(const DeltaEvaluator& ev) {
+    Tour tour;
+    tour.tour = ev.seq;
+    tour.tour_cost = ev.tour_cost;
+    tour.pos = ev.pos;
+    return tour;
+}
@@ -0,0 +1,20 @@
+#include "diagnostics.hpp"
+
+#include <iostream>
+
+static thread_local bool diagnostics_enabled = false;
+
+std::ostream& diagnostics() {
+
+    // a stream without a buffer fails every write, which is all that is needed here
+    static thread_local std::ostream discard(nullptr);
+    return diagnostics_enabled ? std::cerr : discard;
+}
+
+DiagnosticsScope::DiagnosticsScope(bool enabled) : previous(diagnostics_enabled) {
+    diagnostics_enabled = enabled;
+}
+
+DiagnosticsScope::~DiagnosticsScope() {
+    diagnostics_enabled = previous;
+}
@@ -0,0 +1,123 @@
+#include "ils.hpp"
+#include "local_search.hpp"
+#include "improvement.hpp"
+#include "construction.hpp"
+
+#include <algorithm>
+
+void initILS(ILSState& state, Tour& start_solution) {
+    state.current = start_solution;
+    state.best = start_solution;
+    state.initialized = true;
+}
+
+bool doubleBridgeKick(Tour& tour, Graph& graph, mt19937& gen) {
+
+    int n = tour.tour.size();
+    if (n < 4)
+        return false;
+
+    uniform_int_distribution<> dist(1, n - 1);
+
+    for (int attempt = 0; attempt < MAX_KICK_ATTEMPTS; ++attempt) {
+
+        int p[3] = {dist(gen), dist(gen), dist(gen)};
+        sort(p, p + 3);
+        if (p[0] == p[1] || p[1] == p[2])
+            continue;
+
+        // segments: A = [0, p0), B = [p0, p1), C = [p1, p2), D = [p2, n)
+        const vector<int>& t = tour.tour;
+        if (graph.adj[t[p[0] - 1]][t[p[1]]] == -1 ||
+            graph.adj[t[p[2] - 1]][t[p[0]]] == -1 ||
+            graph.adj[t[p[1] - 1]][t[p[2]]] == -1)
+            continue;
+
+        vector<int> kicked;
+        kicked.reserve(n);
+        kicked.insert(kicked.end(), t.begin(), t.begin() + p[0]);
+        kicked.insert(kicked.end(), t.begin() + p[1], t.begin() + p[2]);
+        kicked.insert(kicked.end(), t.begin() + p[0], t.begin() + p[1]);
+        kicked.insert(kicked.end(), t.begin() + p[2], t.end());
+
+        tour.tour = kicked;
+        for (int i = p[0]; i < p[2]; ++i)
+            tour.pos[tour.tour[i]] = i;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool segmentReversalKick(Tour& tour, Graph& graph, mt19937& gen) {
+
+    int n = tour.tour.size();
+    if (n < 4)
+        return false;
+
+    uniform_int_distribution<> dist(0, n - 1);
+
+    for (int attempt = 0; attempt < MAX_KICK_ATTEMPTS; ++attempt) {
+
+        int i = dist(gen), j = dist(gen);
+        // same validity range as the twoOpt loop: j in [i + 2, i - 2] (cyclically)
+        if (j == i || j == (i + 1) % n || j == modified_mod(i - 1, n))
+            continue;
+
+        Tour kicked = applyTwoOptMove(tour, graph, i, j);
+        if (checkTourFeasibility(kicked, graph)) {
+            tour = kicked;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool kickSolution(Tour& tour, Graph& graph, mt19937& gen) {
+
+    bernoulli_distribution coin(0.5);
+
+    if (coin(gen))
+        return doubleBridgeKick(tour, graph, gen) || segmentReversalKick(tour, graph, gen);
+
+    return segmentReversalKick(tour, graph, gen) || doubleBridgeKick(tour, graph, gen);
+}
+
+bool acceptSolution(Tour& candidate, ILSState& state, AcceptanceCriterion acceptance, double threshold) {
+
+    switch (acceptance) {
+    case AcceptanceCriterion::BETTER:
+        return candidate.tour_cost < state.current.tour_cost;
+    case AcceptanceCriterion::RANDOM_WALK:
+        return true;
+    case AcceptanceCriterion::THRESHOLD:
+        return candidate.tour_cost <= (1.0 + threshold) * state.best.tour_cost;
+    }
+
+    return false;
+}
+
+bool ilsStep(ILSState& state, Graph& graph, AcceptanceCriterion acceptance, double threshold,
+             const EngineConfig& engine, mt19937& gen) {
+
+    Tour candidate = state.current;
+
+    if (!kickSolution(candidate, graph, gen))
+        return false;
+
+    calculateTATSPcost(candidate, graph);
+    improveSolution(candidate, graph, engine, gen);
+
+    bool improved = false;
+    if (candidate.tour_cost < state.best.tour_cost) {
+        state.best = candidate;
+        improved = true;
+    }
+
+    if (acceptSolution(candidate, state, acceptance, threshold))
+        state.current = candidate;
+
+    return improved;
+}
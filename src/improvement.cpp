@@ -0,0 +1,300 @@
+#include "improvement.hpp"
+#include "local_search.hpp"
+#include "construction.hpp"
+#include "delta_evaluation.hpp"
+#include "compact_instance.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// Swap, Relocate or 2-Opt (segment reversal) move on the anchored sequence,
+// positions never touch the depot at index 0
+struct SampledMove {
+    int first;
+    int last;
+    int node1;      // nodes that become tabu once the move is applied
+    int node2;
+};
+
+// uniformly random move, used by simulated annealing
+static SampledMove sampleMove(DeltaEvaluator& ev, vector<int>& new_nodes, mt19937& gen) {
+
+    int n = ev.seq.size();
+    uniform_int_distribution<> pos_dist(1, n - 1);
+    uniform_int_distribution<> type_dist(0, 2);
+
+    int i = pos_dist(gen), j = pos_dist(gen);
+    while (j == i)
+        j = pos_dist(gen);
+
+    int first = min(i, j), last = max(i, j);
+
+    switch (type_dist(gen)) {
+    case 0:
+        swapSegment(ev, first, last, new_nodes);
+        return {first, last, ev.seq[first], ev.seq[last]};
+    case 1:
+        relocateSegment(ev, i, j, new_nodes);
+        return {first, last, ev.seq[i], ev.seq[i]};
+    default:
+        reverseSegment(ev, first, last, new_nodes);
+        return {first, last, ev.seq[first], ev.seq[last]};
+    }
+}
+
+// fraction of the budget already spent, in [0, 1]
+static double budgetProgress(const EngineConfig& config, long iteration,
+                             chrono::steady_clock::time_point start_time) {
+
+    double progress = 0;
+    if (config.max_iterations > 0)
+        progress = (double)iteration / config.max_iterations;
+    if (config.time_limit > 0) {
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start_time;
+        progress = max(progress, elapsed.count() / config.time_limit);
+    }
+    return min(progress, 1.0);
+}
+
+void applyDefaultBudget(EngineConfig& config) {
+
+    if (config.max_iterations != 0 || config.time_limit != 0)
+        return;
+
+    if (config.engine == ImprovementEngine::SIMULATED_ANNEALING)
+        config.max_iterations = SA_DEFAULT_ITERATIONS;
+    else if (config.engine == ImprovementEngine::TABU_SEARCH)
+        config.max_iterations = TABU_DEFAULT_ITERATIONS;
+}
+
+void improveSolution(Tour& current_solution, Graph& graph, const EngineConfig& config, mt19937& gen) {
+
+    switch (config.engine) {
+    case ImprovementEngine::LOCAL_SEARCH:
+        localSearch(current_solution, graph, config.dp_window);
+        break;
+    case ImprovementEngine::SIMULATED_ANNEALING:
+        simulatedAnnealing(current_solution, graph, config, gen);
+        break;
+    case ImprovementEngine::TABU_SEARCH:
+        tabuSearch(current_solution, graph, config, gen);
+        break;
+    }
+}
+
+void simulatedAnnealing(Tour& current_solution, Graph& graph, const EngineConfig& engine_config, mt19937& gen) {
+
+    EngineConfig config = engine_config;
+    applyDefaultBudget(config);
+
+    DeltaEvaluator ev;
+    if (current_solution.tour.size() < 4 || !initDeltaEvaluator(ev, current_solution, graph))
+        return;
+
+    vector<int> new_nodes;
+    uniform_real_distribution<> unit(0.0, 1.0);
+
+    // initial temperature: an average uphill move is accepted with probability 0.5
+    double uphill_sum = 0;
+    int uphill_count = 0;
+    for (int k = 0; k < SA_CALIBRATION_MOVES; ++k) {
+        SampledMove move = sampleMove(ev, new_nodes, gen);
+        double delta = evaluateSegmentDelta(ev, graph, move.first, move.last, new_nodes);
+        if (delta > 0 && delta != numeric_limits<double>::infinity()) {
+            uphill_sum += delta;
+            uphill_count++;
+        }
+    }
+    double initial_temperature = (uphill_count > 0) ? (uphill_sum / uphill_count) / log(2.0) : 1.0;
+    double temperature = initial_temperature;
+
+    vector<int> best_seq = ev.seq;
+    double best_cost = ev.tour_cost;
+
+    auto start_time = chrono::steady_clock::now();
+
+    for (long iteration = 0; ; ++iteration) {
+
+        // the clock and the cooling schedule are only refreshed every 100 moves
+        if (iteration % 100 == 0) {
+            double progress = budgetProgress(config, iteration, start_time);
+            if (progress >= 1.0)
+                break;
+            temperature = initial_temperature * pow(SA_FINAL_TEMPERATURE_RATIO, progress);
+        }
+
+        SampledMove move = sampleMove(ev, new_nodes, gen);
+        double delta = evaluateSegmentDelta(ev, graph, move.first, move.last, new_nodes);
+        if (delta == numeric_limits<double>::infinity())
+            continue;
+
+        if (delta <= 0 || unit(gen) < exp(-delta / temperature)) {
+            commitSegment(ev, graph, move.first, new_nodes);
+            if (ev.tour_cost < best_cost) {
+                best_cost = ev.tour_cost;
+                best_seq = ev.seq;
+            }
+        }
+    }
+
+    if (best_cost < current_solution.tour_cost) {
+        current_solution.tour = best_seq;
+        anchorTour(current_solution);
+        calculateTATSPcost(current_solution, graph);
+    }
+}
+
+// successors of each node, cheapest first, at most TABU_CANDIDATES of them; an arc is
+// ranked by the lowest cost it can take (its own or one set by a trigger)
+static vector<vector<int>> candidateSuccessors(Graph& graph) {
+
+    int n = graph.adj.size();
+    vector<vector<int>> candidates(n);
+
+    visitCompactInstance(graph, [&](const auto& instance) {
+        vector<pair<double, int>> successors;
+        for (int u = 0; u < n; ++u) {
+            successors.clear();
+            for (int v = 0; v < n; ++v) {
+                int a = graph.adj[u][v];
+                if (a == -1 || v == u)
+                    continue;
+                double cost = instance.original_cost[a];
+                for (uint32_t r = instance.trigger_begin[a]; r < instance.trigger_begin[a + 1]; ++r)
+                    cost = min(cost, (double)instance.triggers[r].cost);
+                successors.push_back({cost, v});
+            }
+            size_t k = min(successors.size(), (size_t)TABU_CANDIDATES);
+            partial_sort(successors.begin(), successors.begin() + k, successors.end());
+            for (size_t c = 0; c < k; ++c)
+                candidates[u].push_back(successors[c].second);
+        }
+    });
+
+    return candidates;
+}
+
+void tabuSearch(Tour& current_solution, Graph& graph, const EngineConfig& engine_config, mt19937& gen) {
+
+    EngineConfig config = engine_config;
+    applyDefaultBudget(config);
+
+    DeltaEvaluator ev;
+    if (current_solution.tour.size() < 4 || !initDeltaEvaluator(ev, current_solution, graph))
+        return;
+
+    int n = ev.seq.size();
+    int tenure = (config.tabu_tenure > 0) ? config.tabu_tenure : 7 + n / 10;
+
+    vector<vector<int>> candidates = candidateSuccessors(graph);
+
+    // attribute-based memory: a node stays tabu (cannot be moved again) until tabu_until[node]
+    vector<long> tabu_until(n, 0);
+
+    vector<int> new_nodes;
+    vector<int> best_move_nodes;
+
+    vector<int> best_seq = ev.seq;
+    double best_cost = ev.tour_cost;
+
+    // ties between equally good moves are broken at random so the search does not cycle
+    uniform_real_distribution<> unit(0.0, 1.0);
+
+    auto start_time = chrono::steady_clock::now();
+
+    for (long iteration = 1; budgetProgress(config, iteration - 1, start_time) < 1.0; ++iteration) {
+
+        SampledMove best_move = {-1, -1, -1, -1};
+        double best_delta = numeric_limits<double>::infinity();
+        double best_tiebreak = 0;
+
+        auto consider = [&](SampledMove move) {
+            double delta = evaluateSegmentDelta(ev, graph, move.first, move.last, new_nodes);
+            if (delta == numeric_limits<double>::infinity() || delta > best_delta)
+                return;
+
+            bool tabu = tabu_until[move.node1] > iteration || tabu_until[move.node2] > iteration;
+            bool aspiration = ev.tour_cost + delta < best_cost;
+            if (tabu && !aspiration)
+                return;
+
+            double tiebreak = unit(gen);
+            if (delta == best_delta && tiebreak < best_tiebreak)
+                return;
+
+            best_move = move;
+            best_delta = delta;
+            best_tiebreak = tiebreak;
+            best_move_nodes = new_nodes;
+        };
+
+        // the moves that put candidate c right after seq[i - 1] (at position i)
+        for (int i = 1; i < n; ++i) {
+            for (int c : candidates[ev.seq[i - 1]]) {
+                int j = ev.pos[c];
+                if (j == 0 || j == i)
+                    continue;
+                if (j > i) {
+                    swapSegment(ev, i, j, new_nodes);
+                    consider({i, j, ev.seq[i], ev.seq[j]});
+                    if (j > i + 1) {
+                        reverseSegment(ev, i, j, new_nodes);
+                        consider({i, j, ev.seq[i], ev.seq[j]});
+                        relocateSegment(ev, j, i, new_nodes);
+                        consider({i, j, ev.seq[j], ev.seq[j]});
+                    }
+                }
+                else {
+                    // j < i - 1 (j == i - 1 is seq[i - 1] itself)
+                    swapSegment(ev, j, i, new_nodes);
+                    consider({j, i, ev.seq[j], ev.seq[i]});
+                    if (j < i - 2) {
+                        relocateSegment(ev, j, i - 1, new_nodes);
+                        consider({j, i - 1, ev.seq[j], ev.seq[j]});
+                    }
+                }
+            }
+        }
+
+        // no admissible candidate move: fall back to the full Swap + Relocate + 2-Opt neighbourhood
+        if (best_move.first == -1) {
+            for (int i = 1; i < n; ++i) {
+                for (int j = 1; j < n; ++j) {
+                    if (i < j) {
+                        swapSegment(ev, i, j, new_nodes);
+                        consider({i, j, ev.seq[i], ev.seq[j]});
+                        if (j > i + 1) {
+                            reverseSegment(ev, i, j, new_nodes);
+                            consider({i, j, ev.seq[i], ev.seq[j]});
+                        }
+                    }
+                    // relocating to a neighbouring position is the same as an adjacent swap
+                    if (j != i && j != i - 1 && j != i + 1) {
+                        relocateSegment(ev, i, j, new_nodes);
+                        consider({min(i, j), max(i, j), ev.seq[i], ev.seq[i]});
+                    }
+                }
+            }
+        }
+
+        // every neighbour was tabu or infeasible
+        if (best_move.first == -1)
+            break;
+
+        commitSegment(ev, graph, best_move.first, best_move_nodes);
+        tabu_until[best_move.node1] = iteration + tenure;
+        tabu_until[best_move.node2] = iteration + tenure;
+
+        if (ev.tour_cost < best_cost) {
+            best_cost = ev.tour_cost;
+            best_seq = ev.seq;
+        }
+    }
+
+    if (best_cost < current_solution.tour_cost) {
+        current_solution.tour = best_seq;
+        anchorTour(current_solution);
+        calculateTATSPcost(current_solution, graph);
+    }
+}
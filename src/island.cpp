@@ -0,0 +1,175 @@
+#include "island.hpp"
+#include "diagnostics.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <chrono>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static MigrantSlot* slotAt(Island& island, uint64_t ticket) {
+    char* base = reinterpret_cast<char*>(island.header) + sizeof(IslandSegmentHeader);
+    return reinterpret_cast<MigrantSlot*>(base + (ticket % island.header->capacity) * island.header->slot_size);
+}
+
+static int* slotNodes(MigrantSlot* slot) {
+    return reinterpret_cast<int*>(reinterpret_cast<char*>(slot) + sizeof(MigrantSlot));
+}
+
+bool attachIsland(Island& island, const string& name, int id, int num_nodes) {
+
+    island.name = (name[0] == '/') ? name : "/" + name;
+    island.id = id;
+
+    // slots are padded to a cache line so two writers never share one
+    size_t slot_size = sizeof(MigrantSlot) + num_nodes * sizeof(int);
+    slot_size = (slot_size + 63) / 64 * 64;
+    island.size = sizeof(IslandSegmentHeader) + ISLAND_RING_CAPACITY * slot_size;
+
+    bool creator = true;
+    island.fd = shm_open(island.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (island.fd == -1 && errno == EEXIST) {
+        creator = false;
+        island.fd = shm_open(island.name.c_str(), O_RDWR, 0600);
+    }
+    if (island.fd == -1) {
+        diagnostics() << "Error: Cannot open shared memory segment '" << island.name << "': " << strerror(errno) << endl;
+        return false;
+    }
+
+    if (creator) {
+        if (ftruncate(island.fd, island.size) == -1) {
+            diagnostics() << "Error: Cannot size shared memory segment '" << island.name << "'." << endl;
+            close(island.fd);
+            shm_unlink(island.name.c_str());
+            return false;
+        }
+    }
+    else {
+        // the creator may still be sizing the segment
+        struct stat st;
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            if (fstat(island.fd, &st) == 0 && (size_t)st.st_size >= island.size)
+                break;
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        if (fstat(island.fd, &st) != 0 || (size_t)st.st_size != island.size) {
+            diagnostics() << "Error: Shared memory segment '" << island.name << "' belongs to another instance." << endl;
+            close(island.fd);
+            return false;
+        }
+    }
+
+    void* address = mmap(nullptr, island.size, PROT_READ | PROT_WRITE, MAP_SHARED, island.fd, 0);
+    if (address == MAP_FAILED) {
+        diagnostics() << "Error: Cannot map shared memory segment '" << island.name << "'." << endl;
+        close(island.fd);
+        return false;
+    }
+    island.header = static_cast<IslandSegmentHeader*>(address);
+
+    if (creator) {
+        // ftruncate zero-fills the segment, so every slot starts with sequence 0 (empty)
+        island.header->num_nodes = num_nodes;
+        island.header->capacity = ISLAND_RING_CAPACITY;
+        island.header->slot_size = slot_size;
+        island.header->write_ticket.store(0);
+        island.header->magic.store(ISLAND_MAGIC, memory_order_release);
+    }
+    else {
+        for (int attempt = 0; attempt < 100 && island.header->magic.load(memory_order_acquire) != ISLAND_MAGIC; ++attempt)
+            this_thread::sleep_for(chrono::milliseconds(10));
+        if (island.header->magic.load(memory_order_acquire) != ISLAND_MAGIC ||
+            island.header->num_nodes != (uint32_t)num_nodes) {
+            diagnostics() << "Error: Shared memory segment '" << island.name << "' belongs to another instance." << endl;
+            munmap(address, island.size);
+            close(island.fd);
+            island.header = nullptr;
+            return false;
+        }
+    }
+
+    island.header->attached.fetch_add(1);
+
+    // only migrants published from now on are of interest
+    island.next_ticket = island.header->write_ticket.load();
+
+    return true;
+}
+
+void detachIsland(Island& island) {
+
+    if (!island.header)
+        return;
+
+    bool last = island.header->attached.fetch_sub(1) == 1;
+
+    munmap(island.header, island.size);
+    close(island.fd);
+    island.header = nullptr;
+
+    if (last)
+        shm_unlink(island.name.c_str());
+}
+
+void sendMigrant(Island& island, Tour& tour) {
+
+    uint32_t n = island.header->num_nodes;
+    if (tour.tour.size() != n)
+        return;
+
+    uint64_t ticket = island.header->write_ticket.fetch_add(1);
+    MigrantSlot* slot = slotAt(island, ticket);
+
+    slot->sequence.store(2 * ticket + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    slot->source = island.id;
+    slot->cost = tour.tour_cost;
+    int* nodes = slotNodes(slot);
+    for (uint32_t i = 0; i < n; ++i)
+        nodes[i] = tour.tour[i];
+
+    slot->sequence.store(2 * ticket + 2, memory_order_release);
+}
+
+void receiveMigrants(Island& island, vector<Tour>& migrants) {
+
+    uint32_t n = island.header->num_nodes;
+    uint64_t end = island.header->write_ticket.load(memory_order_acquire);
+
+    // migrants older than one lap of the ring have been overwritten
+    if (end - island.next_ticket > island.header->capacity)
+        island.next_ticket = end - island.header->capacity;
+
+    Tour migrant;
+    migrant.tour.resize(n);
+
+    for (; island.next_ticket < end; ++island.next_ticket) {
+
+        uint64_t ticket = island.next_ticket;
+        MigrantSlot* slot = slotAt(island, ticket);
+
+        uint64_t before = slot->sequence.load(memory_order_acquire);
+        if (before < 2 * ticket + 2)
+            break;      // not published yet, retry on the next call
+        if (before > 2 * ticket + 2)
+            continue;   // already overwritten by a later lap
+
+        int source = slot->source;
+        migrant.tour_cost = slot->cost;
+        memcpy(migrant.tour.data(), slotNodes(slot), n * sizeof(int));
+
+        atomic_thread_fence(memory_order_acquire);
+        if (slot->sequence.load(memory_order_relaxed) != before)
+            continue;
+
+        if (source != island.id)
+            migrants.push_back(migrant);
+    }
+}
@@ -1,20 +1,30 @@
 #include "local_search.hpp"
 #include "construction.hpp"
+#include "batch_evaluation.hpp"
+#include "window_dp.hpp"
 
+#include <algorithm>
 
 
-void localSearch(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph) {
+
+void localSearch(Tour& current_solution, Graph& graph, int dp_window) {
 
     bool improved = true;
+
+    // each pass reloads the tour into the same evaluator, so its arrays are allocated once
+    BatchEvaluator be;
     
     while (improved){
 
         improved = false;
-        if (twoOpt(current_solution, all_arcs, graph))
+        if (twoOpt(current_solution, graph))
+            improved = true;
+        else if (swapTwo(current_solution, graph, be))
             improved = true;
-        else if (swapTwo(current_solution, all_arcs, graph))
+        else if (relocate(current_solution, graph, be))
             improved = true;
-        else if (relocate(current_solution, all_arcs, graph))
+        // relocate found nothing, so be.ev still holds current_solution
+        else if (dp_window > 0 && windowDP(current_solution, graph, dp_window, be.ev))
             improved = true;
     }
 
@@ -29,6 +39,8 @@ bool checkTourFeasibility(Tour& tour, const Graph& graph) {
     // cout << endl;
 
     size_t n = tour.tour.size();
+    if (n == 0)
+        return false;
     
     for (size_t i = 0; i < n - 1; ++i) {
 
@@ -50,21 +62,33 @@ bool checkTourFeasibility(Tour& tour, const Graph& graph) {
     return true;
 }
 
-bool twoOpt(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph ) {
+bool twoOpt(Tour& current_solution, Graph& graph ) {
 
     int n = graph.adj.size(); // number of vertices
     Tour new_tour;
-    for (int i = 0; i < n; i++) {
-        for (int j = (i + 2) % n; j != modified_mod(i - 1, n); j = (j + 1) % n) {
-            new_tour = applyTwoOptMove(current_solution, graph, i, j);
-            if (checkTourFeasibility(new_tour, graph)) {
-                calculateTATSPcost(new_tour, all_arcs, graph);
-                if (new_tour.tour_cost < current_solution.tour_cost) {
-                    current_solution = new_tour;
-                    return true;
-                }
+
+    // removes the arcs leaving positions i and j (arc n - 1 is the closing arc) and reverses
+    // the nodes between them; the segment holds the depot when j wraps around to j < i
+    auto tryMove = [&](int i, int j) {
+        new_tour = applyTwoOptMove(current_solution, graph, i, j);
+        if (checkTourFeasibility(new_tour, graph)) {
+            if (calculateTATSPcostBounded(new_tour, graph, current_solution.tour_cost)) {
+                current_solution = new_tour;
+                return true;
             }
-        }  
+        }
+        return false;
+    };
+
+    for (int i = 0; i < n; i++) {
+        // j after i, at most up to the closing arc (for i == 0 it is adjacent to arc 0)
+        for (int j = i + 2; j < n && j < i + n - 1; j++)
+            if (tryMove(i, j))
+                return true;
+        // then past the closing arc, back from the depot up to two arcs before i
+        for (int j = max(0, i + 2 - n); j <= i - 2; j++)
+            if (tryMove(i, j))
+                return true;
     }
 
     return false;
@@ -74,23 +98,27 @@ bool twoOpt(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph ) {
 Tour applyTwoOptMove(Tour& tour, Graph& graph, int arc1_source, int arc2_source) {
 
     int n = graph.adj.size(); // number of vertices
-    int idx1 = (arc1_source + 1) % n;
+    int idx1 = (arc1_source + 1 == n) ? 0 : arc1_source + 1;
     int idx2 = arc2_source;
     //the tour section from idx1 to idx2 has its order reversed
 
     Tour new_tour(tour);
+    vector<int>& t = new_tour.tour;
 
-    int i = idx1, j = idx2;
-
-    while (i != (idx2 + 1) % n){
-        new_tour.tour[i] = tour.tour[j];
-        if (new_tour.tour[i] == 0)
-            new_tour.depot_idx = i;
-        i = (i + 1) % n;
-        j = modified_mod(j - 1, n);  
-    }  
-
-    // cout << new_tour.depot_idx << endl;
+    if (idx1 >= 1 && idx1 <= idx2) {
+        reverse(t.begin() + idx1, t.begin() + idx2 + 1);
+        for (int i = idx1; i <= idx2; ++i)
+            new_tour.pos[t[i]] = i;
+    }
+    else {
+        // the section holds the depot: reversing the rest of the cycle instead gives the
+        // same cycle walked backwards, which reversing tour[1..n-1] turns around again
+        int rest_end = (idx1 == 0) ? n : idx1;
+        reverse(t.begin() + idx2 + 1, t.begin() + rest_end);
+        reverse(t.begin() + 1, t.end());
+        for (int i = 0; i < n; ++i)
+            new_tour.pos[t[i]] = i;
+    }
 
     return new_tour;
     
@@ -100,32 +128,51 @@ Tour applySwapTwoMove(Tour& tour, int idx1, int idx2) {
 
     Tour new_tour(tour);
 
-    if (new_tour.tour[idx1] == 0)
-        new_tour.depot_idx = idx2;
-    else if (new_tour.tour[idx2] == 0)
-        new_tour.depot_idx = idx1;
-
     int aux = new_tour.tour[idx1];
 
     new_tour.tour[idx1] = new_tour.tour[idx2];
 
     new_tour.tour[idx2] = aux;
 
+    // moving the depot changes the start of the tour
+    if (idx1 == 0 || idx2 == 0) {
+        anchorTour(new_tour);
+    }
+    else {
+        new_tour.pos[new_tour.tour[idx1]] = idx1;
+        new_tour.pos[new_tour.tour[idx2]] = idx2;
+    }
+
     return new_tour;
     
 }
 
-bool swapTwo(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph){
+bool swapTwo(Tour& current_solution, Graph& graph, BatchEvaluator& be){
 
     int n = graph.adj.size(); // number of vertices
     Tour new_tour;
 
+    // swaps that do not move the depot (i > 0) are scored in one batch per row,
+    // only the improving ones are then applied and checked exactly
+    bool batch = initBatchEvaluator(be, current_solution, graph);
+    vector<CandidateMove> moves;
+
     for (int i = 0; i < n - 1; ++i) {
+        bool batch_row = batch && i != 0;
+
+        moves.clear();
+        if (batch_row) {
+            for (int j = i + 1; j < n; ++j)
+                moves.push_back({MoveType::SWAP, i, j, 0});
+            evaluateMoves(be, graph, moves);
+        }
+
         for (int j = i + 1; j < n; ++j) {
+            if (batch_row && moves[j - i - 1].delta >= 0)
+                continue;
             new_tour = applySwapTwoMove(current_solution, i, j);
             if (checkTourFeasibility(new_tour, graph)) {
-                calculateTATSPcost(new_tour, all_arcs, graph);
-                if (new_tour.tour_cost < current_solution.tour_cost) {
+                if (calculateTATSPcostBounded(new_tour, graph, current_solution.tour_cost)) {
                     current_solution = new_tour;
                     return true;
                 }
@@ -138,19 +185,36 @@ bool swapTwo(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph){
 }
 
 
-bool relocate(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph){
+bool relocate(Tour& current_solution, Graph& graph, BatchEvaluator& be){
 
     int n = graph.adj.size(); // number of vertices
     Tour new_tour;
 
+    // same batching as swapTwo, for the moves whose shifted range does not contain the depot
+    bool batch = initBatchEvaluator(be, current_solution, graph);
+    vector<CandidateMove> moves;
+
+    auto batched = [&](int i, int j) {
+        return batch && i != 0 && j != 0;
+    };
+
     for (int i = 0; i < n; ++i) {
+
+        moves.clear();
+        for (int j = 0; j < n; ++j)
+            if (!(i == j - 1 || i == j || i == j + 1) && batched(i, j))
+                moves.push_back({MoveType::RELOCATE, i, j, 0});
+        evaluateMoves(be, graph, moves);
+
+        size_t m = 0;
         for (int j = 0; j < n; ++j) {
             if (i == j - 1 || i == j || i == j + 1) 
                 continue;
+            if (batched(i, j) && moves[m++].delta >= 0)
+                continue;
             new_tour = applyRelocateMove(current_solution, i, j);
             if (checkTourFeasibility(new_tour, graph)) {
-                calculateTATSPcost(new_tour, all_arcs, graph);
-                if (new_tour.tour_cost < current_solution.tour_cost) {
+                if (calculateTATSPcostBounded(new_tour, graph, current_solution.tour_cost)) {
                     current_solution = new_tour;
                     return true;
                 }
@@ -165,18 +229,12 @@ bool relocate(Tour& current_solution, vector<Arc>& all_arcs, Graph& graph){
 Tour applyRelocateMove(Tour& tour, int initial_idx, int new_idx){
 
     Tour new_tour(tour);
-    int current_depot = new_tour.depot_idx;
 
     if (initial_idx < new_idx) {
         int aux = new_tour.tour[initial_idx];
         for (int i = initial_idx; i < new_idx; i++)
             new_tour.tour[i] = new_tour.tour[i+1];
         new_tour.tour[new_idx] = aux;
-
-        if (current_depot == initial_idx)
-             new_tour.depot_idx = new_idx; 
-        else if (current_depot > initial_idx && current_depot <= new_idx)
-             new_tour.depot_idx--;
     }
 
     else {
@@ -184,11 +242,16 @@ Tour applyRelocateMove(Tour& tour, int initial_idx, int new_idx){
         for (int i = initial_idx; i > new_idx; i--)
             new_tour.tour[i] = new_tour.tour[i-1];
         new_tour.tour[new_idx] = aux;
+    }
 
-        if (current_depot == initial_idx)
-             new_tour.depot_idx = new_idx; 
-        else if (current_depot >= new_idx && current_depot < initial_idx)
-             new_tour.depot_idx++;
+    // only the shifted range moved, unless it held the depot
+    int low = min(initial_idx, new_idx), high = max(initial_idx, new_idx);
+    if (low == 0) {
+        anchorTour(new_tour);
+    }
+    else {
+        for (int i = low; i <= high; i++)
+            new_tour.pos[new_tour.tour[i]] = i;
     }
 
     return new_tour;
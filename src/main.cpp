@@ -1,30 +1,121 @@
 #include "parser.hpp"
-#include "construction.hpp"
 #include "datatypes.hpp"
-#include "local_search.hpp"
-#include "path_relinking.hpp"
+#include "tatsp.hpp"
+#include "benchmark.hpp"
+#include "compact_instance.hpp"
+#include "improvement.hpp"
+#include "reactive.hpp"
+#include "preprocessing.hpp"
+#include "diagnostics.hpp"
 
-#include <chrono>
 #include <vector>   // NEW: Include for vector
 #include <string>   // NEW: Include for string processing
+#include <sstream>
+#include <iostream>
+#include <fstream>
 
 using namespace std;
 
-const int POOL_SIZE = 10;
-
 
 int main(int argc, char **argv) {
     // 1. Argument Parsing and Validation
 
     // --- NEW: Argument parsing logic ---
-    bool path_flag = false;
+    // the library stays silent unless asked, the command line tool wants its error messages
+    DiagnosticsScope diagnostics_scope(true);
+
+    SolverConfig config;
+    config.verbose = true;
+    string acceptance_str = "better";
+    string engine_str = "ls";
     vector<string> positional_args;
+    BenchmarkConfig bench;
+    bench.runs = 0;
+    string csv_file;
 
     // Loop through all command-line arguments (starting from 1, skipping executable name)
     for (int i = 1; i < argc; ++i) {
         string arg = argv[i];
         if (arg == "-pr") {
-            path_flag = true;
+            config.path_relinking = true;
+        } else if (arg == "-pr-guides" && i + 1 < argc) {
+            config.pr_guides = stoi(argv[++i]);
+        } else if (arg == "-pr-threads" && i + 1 < argc) {
+            config.pr_threads = stoi(argv[++i]);
+        } else if (arg == "-reactive") {
+            config.reactive = true;
+        } else if (arg == "-ils" && i + 1 < argc) {
+            config.ils_kicks = stoi(argv[++i]);
+        } else if (arg == "-ils-only") {
+            config.ils_only = true;
+        } else if (arg == "-accept" && i + 1 < argc) {
+            acceptance_str = argv[++i];
+            if (acceptance_str == "better") config.acceptance = AcceptanceCriterion::BETTER;
+            else if (acceptance_str == "walk") config.acceptance = AcceptanceCriterion::RANDOM_WALK;
+            else if (acceptance_str == "threshold") config.acceptance = AcceptanceCriterion::THRESHOLD;
+            else {
+                cerr << "Error: Invalid acceptance criterion. Use better, walk or threshold." << endl;
+                return 1;
+            }
+        } else if (arg == "-threshold" && i + 1 < argc) {
+            config.ils_threshold = stod(argv[++i]);
+        } else if (arg == "-engine" && i + 1 < argc) {
+            engine_str = argv[++i];
+            if (engine_str == "ls") config.engine.engine = ImprovementEngine::LOCAL_SEARCH;
+            else if (engine_str == "sa") config.engine.engine = ImprovementEngine::SIMULATED_ANNEALING;
+            else if (engine_str == "tabu") config.engine.engine = ImprovementEngine::TABU_SEARCH;
+            else {
+                cerr << "Error: Invalid improvement engine. Use ls, sa or tabu." << endl;
+                return 1;
+            }
+        } else if (arg == "-engine-iters" && i + 1 < argc) {
+            config.engine.max_iterations = stol(argv[++i]);
+        } else if (arg == "-engine-time" && i + 1 < argc) {
+            config.engine.time_limit = stod(argv[++i]);
+        } else if (arg == "-tabu-tenure" && i + 1 < argc) {
+            config.engine.tabu_tenure = stoi(argv[++i]);
+        } else if (arg == "-checkpoint" && i + 1 < argc) {
+            config.checkpoint_file = argv[++i];
+        } else if (arg == "-checkpoint-every" && i + 1 < argc) {
+            config.checkpoint_interval = stod(argv[++i]);
+        } else if (arg == "-resume" && i + 1 < argc) {
+            config.resume_file = argv[++i];
+        } else if (arg == "-init" && i + 1 < argc) {
+            config.init_file = argv[++i];
+        } else if (arg == "-island" && i + 2 < argc) {
+            config.island_name = argv[++i];
+            config.island_id = stoi(argv[++i]);
+        } else if (arg == "-migrate-every" && i + 1 < argc) {
+            config.migration_interval = stoi(argv[++i]);
+        } else if (arg == "-migrate-policy" && i + 1 < argc) {
+            string policy_str = argv[++i];
+            if (policy_str == "best") config.migration_policy = MigrationPolicy::BEST;
+            else if (policy_str == "random") config.migration_policy = MigrationPolicy::RANDOM_ELITE;
+            else {
+                cerr << "Error: Invalid migration policy. Use best or random." << endl;
+                return 1;
+            }
+        } else if (arg == "-dp-window" && i + 1 < argc) {
+            config.engine.dp_window = stoi(argv[++i]);
+        } else if (arg == "-seed" && i + 1 < argc) {
+            config.seed = stoul(argv[++i]);
+        } else if (arg == "-bench" && i + 1 < argc) {
+            bench.runs = stoi(argv[++i]);
+        } else if (arg == "-bench-threads" && i + 1 < argc) {
+            bench.threads = stoi(argv[++i]);
+        } else if (arg == "-targets" && i + 1 < argc) {
+            // comma separated list of target costs
+            string targets_str = argv[++i];
+            for (char& c : targets_str)
+                if (c == ',') c = ' ';
+            istringstream targets_in(targets_str);
+            double target;
+            while (targets_in >> target)
+                bench.targets.push_back(target);
+        } else if (arg == "-csv" && i + 1 < argc) {
+            csv_file = argv[++i];
+        } else if (arg == "-preprocess") {
+            config.preprocess = true;
         } else {
             // This is not a flag we recognize, assume it's a positional argument
             positional_args.push_back(arg);
@@ -36,17 +127,27 @@ int main(int argc, char **argv) {
     // MODIFIED: Check if we have the correct number of POSITIONAL arguments
     if (positional_args.size() < 4) {
         // MODIFIED: Updated usage message
-        cout << "Usage: " << argv[0] << " <filename> <pert_type> <pert_param> <time_limit> [-pr]" << endl;
+        cout << "Usage: " << argv[0] << " <filename> <pert_type> <pert_param> <time_limit> [-pr] [-pr-guides <m>] [-pr-threads <k>] [-reactive] [-ils <kicks>] [-ils-only] [-accept <better|walk|threshold>] [-threshold <value>] [-engine <ls|sa|tabu>] [-engine-iters <n>] [-engine-time <seconds>] [-tabu-tenure <k>] [-checkpoint <file>] [-checkpoint-every <seconds>] [-resume <file>] [-init <tour file>] [-island <name> <id>] [-migrate-every <iterations>] [-migrate-policy <best|random>] [-preprocess] [-dp-window <k>] [-seed <s>] [-bench <runs>] [-bench-threads <k>] [-targets <c1,c2,...>] [-csv <file>]" << endl;
         cout << "Perturbation Types: 0 (NONE), 1 (ADDITIVE), 2 (MULTIPLICATIVE)" << endl;
         cout << "Optional flag: -pr (to enable Path Relinking)" << endl; // NEW
+        cout << "Optional flag: -pr-guides <m> (relink against the m best pool members in both directions, in parallel)" << endl;
+        cout << "Optional flag: -pr-threads <k> (workers of those relinkings, default one per hardware thread)" << endl;
+        cout << "Optional flag: -reactive (to self-tune the perturbation type and parameter, using <pert_param> as base scale)" << endl;
+        cout << "Optional flag: -ils <kicks> (Iterated Local Search kicks after each GRASP iteration), -ils-only (a single construction, then only kicks)" << endl;
+        cout << "Optional flag: -engine <ls|sa|tabu> (improvement method after construction, Path Relinking and ILS kicks)" << endl;
+        cout << "Optional flag: -checkpoint <file> (periodic and final checkpoint), -resume <file> or -init <tour file> (warm start)" << endl;
+        cout << "Optional flag: -island <name> <id> (exchange elite tours with the other solver processes using the same shared memory name)" << endl;
+        cout << "Optional flag: -dp-window <k> (reorder windows of k consecutive nodes with a Held-Karp DP in the local search, k from 3 to 16)" << endl;
+        cout << "Optional flag: -bench <runs> (independent runs with seeds <s>, <s>+1, ... in parallel; summary, time-to-target and -csv output)" << endl;
+        cout << "Optional flag: -preprocess (remove redundant arcs and relations, contract forced paths before the search)" << endl;
         return 1;
     }
 
     // MODIFIED: Parse arguments from our new vector
     string filename = positional_args[0];
     int pert_type_int = stoi(positional_args[1]);
-    double pert_parameter = stod(positional_args[2]);
-    double time_limit = stod(positional_args[3]);
+    config.pert_parameter = stod(positional_args[2]);
+    config.time_limit = stod(positional_args[3]);
 
     ifstream file(filename);
     if (!file.is_open()) {
@@ -55,29 +156,19 @@ int main(int argc, char **argv) {
     }
     file.close();
 
-    if (pert_parameter < 0) {
-        cerr << "Error: Perturbation parameter must be non-negative." << endl;
-        return 1;
-    }
-    if (time_limit <= 0) {
-        cerr << "Error: Time limit must be positive." << endl;
-        return 1;
-    }
-
-    PerturbationType pert_type;
     string pert_type_str;
 
     switch (pert_type_int) {
         case 0: 
-            pert_type = PerturbationType::NONE;
+            config.pert_type = PerturbationType::NONE;
             pert_type_str = "NONE"; 
             break;
         case 1: 
-            pert_type = PerturbationType::ADDITIVE;
+            config.pert_type = PerturbationType::ADDITIVE;
             pert_type_str = "ADDITIVE"; 
             break;
         case 2: 
-            pert_type = PerturbationType::MULTIPLICATIVE;
+            config.pert_type = PerturbationType::MULTIPLICATIVE;
             pert_type_str = "MULTIPLICATIVE"; 
             break;
         default:
@@ -85,89 +176,86 @@ int main(int argc, char **argv) {
             return 1;
     }
 
+    applyDefaultBudget(config.engine);
+
     // 2. Initialization
     Graph graph;
     vector<Arc> all_arcs;
     parser(filename, graph, all_arcs);
 
-    // vector<Tour> pool;
-    // pool.reserve(2000);
-
-    cout << "Starting search for " << time_limit << " seconds..." << endl;
-    cout << "Configuration: Type=" << pert_type_str << ", Param=" << pert_parameter << endl;
-    cout << "Path Relinking: " << (path_flag ? "ENABLED" : "DISABLED") << endl; // NEW: Report PR status
-
-    // 3. Search Loop
-    auto start_time = chrono::steady_clock::now();
-
-    random_device rd;
-
-    mt19937 gen_grasp(rd());
-    mt19937 gen_pr(rd());
-
-    
-    int best_iteration = 0;
-
-    Tour best_tour;
-    best_tour.tour_cost = numeric_limits<double>::infinity();
-    int count = 0;
-    vector<Tour> pool;
-    pool.reserve(POOL_SIZE);
-    while (true) {
-        // Use duration<double> for precise comparison against the double time_limit
-        chrono::duration<double> elapsed = chrono::steady_clock::now() - start_time;
-        if (elapsed.count() >= time_limit) {
-            break;
-        }
-
-        Tour solution_tour;
-        // MODIFICATION: Capture the return status from constructiveHeuristic
-        int construct_status = constructiveHeuristic(graph, all_arcs, solution_tour, pert_type, pert_parameter, gen_grasp);
-        
-        // MODIFICATION: If construction failed, skip local search and recording
-        if (construct_status == -1) {
-            // This iteration failed to find a feasible solution, skip to the next
-            count++;
-            continue;
-        }
+    size_t num_relations = 0;
+    for (const Arc& arc : all_arcs)
+        num_relations += arc.targets.size();
+    cout << "Successfully read " << graph.adj.size() << " nodes, "
+         << all_arcs.size() << " arcs, and "
+         << num_relations << " relations from " << filename << "." << endl;
+
+    cout << "Starting search for " << config.time_limit << " seconds..." << endl;
+    if (graph.compact)
+        cout << "Instance Layout: " << describeCompactLayout(*graph.compact) << endl;
+    if (config.reactive)
+        cout << "Configuration: Type=REACTIVE, Base Param=" << config.pert_parameter << endl;
+    else
+        cout << "Configuration: Type=" << pert_type_str << ", Param=" << config.pert_parameter << endl;
+    cout << "Path Relinking: " << (config.path_relinking ? "ENABLED" : "DISABLED") << endl; // NEW: Report PR status
+    if (config.path_relinking && config.pr_guides > 1)
+        cout << "Path Relinking Guides: " << config.pr_guides << " (parallel, both directions)" << endl;
+    if (config.ils_only)
+        cout << "Iterated Local Search: PURE, Acceptance=" << acceptance_str << endl;
+    else if (config.ils_kicks > 0)
+        cout << "Iterated Local Search: " << config.ils_kicks << " kicks per iteration, Acceptance=" << acceptance_str << endl;
+    if (config.engine.engine != ImprovementEngine::LOCAL_SEARCH)
+        cout << "Improvement Engine: " << engine_str << ", Iterations=" << config.engine.max_iterations
+             << ", Time=" << config.engine.time_limit << endl;
+
+    if (config.engine.dp_window > 0)
+        cout << "DP Window: " << config.engine.dp_window << " nodes" << endl;
+
+    if (!config.island_name.empty())
+        cout << "Island Model: Segment=" << config.island_name << ", Id=" << config.island_id
+             << ", Migration Every " << config.migration_interval << " Iterations" << endl;
+
+    // 3. Search
+    if (bench.runs > 0) {
+        if (config.seed != 0)
+            bench.base_seed = config.seed;
+        cout << "Benchmark: " << bench.runs << " runs, Seeds " << bench.base_seed << ".."
+             << bench.base_seed + bench.runs - 1 << endl;
+
+        BenchmarkResult bench_result;
+        if (runBenchmark(graph, all_arcs, config, bench, bench_result) == -1)
+            return 1;
 
-        localSearch(solution_tour, all_arcs, graph);
+        cout << "------------------------------------------------" << endl;
+        printBenchmarkSummary(bench, bench_result);
 
-        if (path_flag) {
-            if (pool.size() < POOL_SIZE) {
-                pool.push_back(solution_tour);
+        if (!csv_file.empty()) {
+            ofstream csv(csv_file);
+            if (!csv.is_open()) {
+                cerr << "Error: Cannot write CSV file '" << csv_file << "'." << endl;
+                return 1;
             }
-            
-            else {
-                Tour guidingSolution = pool[selectGuidingSolution(solution_tour, pool, gen_pr)];
-                solution_tour = mixedPathRelinking(solution_tour, guidingSolution, graph, all_arcs);
-                localSearch(solution_tour, all_arcs, graph);
-                updatePool(solution_tour, pool);
-            }
-
+            writeBenchmarkCSV(csv, bench, bench_result);
+            cout << "Per-run results written to " << csv_file << endl;
         }
-
-
-        if (solution_tour.tour_cost < best_tour.tour_cost) {
-            best_tour = solution_tour;
-            best_iteration = count;
-        }
-
-        count++;
+        return 0;
     }
 
+    SolverResult result;
+    if (solveTATSP(graph, all_arcs, config, result) == -1)
+        return 1;
 
-
+    Tour& best_tour = result.best_tour;
 
     // 4. Results Reporting
-    if (best_iteration == 0) {
+    if (best_tour.tour.empty()) {
         cout << "No solutions found within time limit." << endl;
         return 0;
     }
 
     cout << "------------------------------------------------" << endl;
     cout << "Search Finished." << endl;
-    cout << "Total Iterations: " << count << endl;
+    cout << "Total Iterations: " << result.stats.iterations << endl;
     cout << "Best Tour Cost: " << best_tour.tour_cost << endl;
     cout << "Best Tour Path: ";
 
@@ -183,7 +271,11 @@ int main(int argc, char **argv) {
         cout << "[Empty Tour]" << endl;
     }
     
-    cout << "Best Tour Found at Iteration: " << best_iteration << endl;
+    cout << "Best Tour Found at Iteration: " << result.stats.best_iteration << endl;
+
+    if (config.reactive)
+        printReactiveDistribution(result.stats.reactive);
+
     cout << endl;
             
     return 0;
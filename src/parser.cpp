@@ -1,4 +1,11 @@
 #include "parser.hpp"
+#include "datatypes.hpp"
+#include "compact_instance.hpp"
+#include "diagnostics.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
 
 void parser(const string& filename, Graph& graph, vector<Arc>& all_arcs) {
     
@@ -7,7 +14,7 @@ void parser(const string& filename, Graph& graph, vector<Arc>& all_arcs) {
 
     // --- Check if file opened successfully ---
     if (!infile.is_open()) {
-        cerr << "Error: Could not open file " << filename << endl;
+        diagnostics() << "Error: Could not open file " << filename << endl;
         return; 
     }
 
@@ -17,9 +24,8 @@ void parser(const string& filename, Graph& graph, vector<Arc>& all_arcs) {
     infile >> num_nodes >> num_arcs >> num_relations; 
 
     // 2. Initialize Your Objects
-    graph.adj.resize(num_nodes, vector<int>(num_nodes, -1));
-
-    all_arcs.resize(num_arcs);
+    vector<InstanceArc> arcs(num_arcs);
+    vector<InstanceRelation> relations(num_relations);
 
     // 3. Read the |A| Arc Lines (from file)
     for (int i = 0; i < num_arcs; ++i) {
@@ -28,12 +34,7 @@ void parser(const string& filename, Graph& graph, vector<Arc>& all_arcs) {
         
         infile >> arc_idx >> from_node >> to_node >> cost;
 
-        all_arcs[arc_idx].from = from_node;
-        all_arcs[arc_idx].to = to_node;
-        all_arcs[arc_idx].original_cost = cost;
-        all_arcs[arc_idx].current_cost = cost; 
-        
-        graph.adj[from_node][to_node] = arc_idx;
+        arcs[arc_idx] = {from_node, to_node, cost};
     }
 
     // 4. Read the |R| Relation Lines (from file)
@@ -48,17 +49,50 @@ void parser(const string& filename, Graph& graph, vector<Arc>& all_arcs) {
                >> target_arc_idx >> target_from >> target_to
                >> new_cost;
             
-        all_arcs[trigger_arc_idx].targets.push_back({target_arc_idx, new_cost});
-        all_arcs[target_arc_idx].triggers.push_back(trigger_arc_idx);
+        relations[i] = {trigger_arc_idx, target_arc_idx, new_cost};
     }
 
     // --- Good practice: close the file when done ---
     infile.close();
 
-    cout << "Successfully read " << num_nodes << " nodes, "
-         << num_arcs << " arcs, and "
-         << num_relations << " relations from " << filename << "." << endl;
+    buildInstance(num_nodes, arcs, relations, graph, all_arcs);
 
-    
     return;
-}
\ No newline at end of file
+}
+
+void buildInstance(int num_nodes, const vector<InstanceArc>& arcs, const vector<InstanceRelation>& relations,
+                   Graph& graph, vector<Arc>& all_arcs, vector<int>* arc_order) {
+
+    // arcs are numbered by tail, then head: graph.adj then only stores node-sized ranks
+    vector<int> order(arcs.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        if (arcs[a].from != arcs[b].from) return arcs[a].from < arcs[b].from;
+        return arcs[a].to < arcs[b].to;
+    });
+
+    vector<int> index(arcs.size());
+    for (size_t k = 0; k < arcs.size(); ++k)
+        index[order[k]] = k;
+
+    all_arcs.assign(arcs.size(), Arc());
+
+    for (size_t k = 0; k < arcs.size(); ++k) {
+        const InstanceArc& arc = arcs[order[k]];
+        all_arcs[k].from = arc.from;
+        all_arcs[k].to = arc.to;
+        all_arcs[k].original_cost = arc.cost;
+        all_arcs[k].current_cost = arc.cost;
+    }
+
+    for (const InstanceRelation& relation : relations) {
+        int trigger = index[relation.trigger_arc], target = index[relation.target_arc];
+        all_arcs[trigger].targets.push_back({target, relation.new_cost});
+        all_arcs[target].triggers.push_back(trigger);
+    }
+
+    buildCompactInstance(num_nodes, all_arcs, graph);
+
+    if (arc_order)
+        *arc_order = order;
+}
@@ -1,11 +1,15 @@
 #include "path_relinking.hpp"
 #include "local_search.hpp"
 #include "construction.hpp"
+#include "batch_evaluation.hpp"
 
 #include <algorithm>
 #include <random>
+#include <atomic>
+#include <thread>
 
-void applyPathRelinkingMove(Tour& current_solution, Tour& guiding_solution, Graph& graph, vector<Arc>& all_arcs) {
+void applyPathRelinkingMove(Tour& current_solution, Tour& guiding_solution, Graph& graph,
+                            BatchEvaluator& be) {
 
     pair<int, int> bestSwap(-1, -1);
     pair<int, int> emergencySwap(-1, -1);
@@ -13,51 +17,87 @@ void applyPathRelinkingMove(Tour& current_solution, Tour& guiding_solution, Grap
     double bestSwapCost = numeric_limits<double>::infinity();
     int n = current_solution.tour.size();
 
-    size_t depot1_idx = current_solution.depot_idx;
-    size_t depot2_idx = guiding_solution.depot_idx;
+    const vector<int>& current = current_solution.tour;
+    const vector<int>& guiding = guiding_solution.tour;
+
+    // candidate swaps (i, j), i < j: current[i] == guiding[j] or current[j] == guiding[i].
+    // Both tours start at the depot, so the pos arrays give them directly from each mismatch
+    vector<pair<int, int>> candidates;
+    for (int i = 1; i < n; i++){
+        if (current[i] == guiding[i])
+            continue;
+        int j1 = guiding_solution.pos[current[i]];
+        int j2 = current_solution.pos[guiding[i]];
+        candidates.push_back(make_pair(min(i, j1), max(i, j1)));
+        candidates.push_back(make_pair(min(i, j2), max(i, j2)));
+    }
+    sort(candidates.begin(), candidates.end());
+    candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+
+    if (!candidates.empty())
+        emergencySwap = candidates.back();
 
     Tour temp;
-    
-    for (int i = 0; i < n - 1; i++){
-        for (int j = i + 1; j < n; j++){
-
-            size_t i1 = (depot1_idx + i) % n ; size_t i2 = (depot2_idx + i) % n; 
-            size_t j1 = (depot1_idx + j) % n ; size_t j2 = (depot2_idx + j) % n; 
-
-            if (current_solution.tour[i1] == guiding_solution.tour[j2] || current_solution.tour[j1] == guiding_solution.tour[i2]){
-                emergencySwap = make_pair(i1, j1);
-                temp = applySwapTwoMove(current_solution, i1, j1);
-                if (checkTourFeasibility(temp, graph)) {
-                    calculateTATSPcost(temp, all_arcs, graph);
-                    if (temp.tour_cost < bestSwapCost) {
-                        bestSwap = make_pair(i1,j1);
-                        bestSwapCost = temp.tour_cost;
-                    }
+
+    // all candidate swaps of this step are scored in one batch; an infeasible
+    // current solution (after an emergency swap) falls back to full evaluation
+    if (initBatchEvaluator(be, current_solution, graph)) {
+
+        vector<CandidateMove> moves;
+        for (auto& [i, j] : candidates)
+            moves.push_back({MoveType::SWAP, i, j, 0});
+
+        evaluateMoves(be, graph, moves);
+        int best = selectBestMove(moves);
+
+        if (best != -1 && moves[best].delta != numeric_limits<double>::infinity()) {
+            bestSwap = make_pair(moves[best].i, moves[best].j);
+        }
+    }
+
+    else {
+        for (auto& [i, j] : candidates){
+            temp = applySwapTwoMove(current_solution, i, j);
+            if (checkTourFeasibility(temp, graph)) {
+                if (calculateTATSPcostBounded(temp, graph, bestSwapCost)) {
+                    bestSwap = make_pair(i, j);
+                    bestSwapCost = temp.tour_cost;
                 }
             }
         }
     }
 
+    // the batch delta only ranks the candidates, the accepted tour gets its exact cost
+    // so that tours reached along different paths compare equal (pool, operator==)
     if (bestSwap != make_pair(-1, -1)){
         current_solution = applySwapTwoMove(current_solution, bestSwap.first, bestSwap.second);
-        current_solution.tour_cost = bestSwapCost;
+        calculateTATSPcost(current_solution, graph);
     }
     else {
+        // no feasible candidate, so the emergency swap leaves an infeasible tour
         current_solution = applySwapTwoMove(current_solution, emergencySwap.first, emergencySwap.second);
+        current_solution.tour_cost = numeric_limits<double>::infinity();
     }
     
 }
 
-Tour mixedPathRelinking(Tour solution1, Tour solution2, Graph& graph, vector<Arc>& all_arcs) {
+Tour mixedPathRelinking(Tour solution1, Tour solution2, Graph& graph,
+                        vector<Tour>* intermediates) {
 
     Tour best_solution = (solution1.tour_cost < solution2.tour_cost) ? solution1 : solution2;
 
+    // reloaded at every step, its arrays are allocated once per path
+    BatchEvaluator be;
+
     while (calculateHammingDistance(solution1, solution2) > 0) {
-        applyPathRelinkingMove(solution1, solution2, graph, all_arcs);
+        applyPathRelinkingMove(solution1, solution2, graph, be);
 
         if (checkTourFeasibility(solution1, graph))
-            if (solution1.tour_cost < best_solution.tour_cost)
+            if (solution1.tour_cost < best_solution.tour_cost) {
                 best_solution = solution1;
+                if (intermediates)
+                    intermediates->push_back(solution1);
+            }
         
         swap(solution1, solution2);
     }
@@ -66,16 +106,64 @@ Tour mixedPathRelinking(Tour solution1, Tour solution2, Graph& graph, vector<Arc
         
 }
 
+Tour multiGuidePathRelinking(Tour& solution, vector<Tour>& pool, int guides, int max_workers, Graph& graph,
+                             vector<Tour>& intermediates) {
+
+    // cheapest pool members first, a guide equal to the solution has no path to explore
+    vector<int> order;
+    for (size_t i = 0; i < pool.size(); i++)
+        if (calculateHammingDistance(solution, pool[i]) > 0)
+            order.push_back(i);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return pool[a].tour_cost < pool[b].tour_cost; });
+    if ((int)order.size() > guides)
+        order.resize(guides);
+
+    // two tasks per guide: solution -> guide and guide -> solution
+    size_t num_tasks = 2 * order.size();
+    vector<Tour> results(num_tasks);
+    vector<vector<Tour>> task_intermediates(num_tasks);
+
+    size_t num_workers = (max_workers > 0) ? max_workers : max(1u, thread::hardware_concurrency());
+    num_workers = min(num_workers, num_tasks);
+
+    // each worker takes the next pending relinking until none is left
+    atomic<size_t> next_task{0};
+    auto worker = [&]() {
+        for (size_t t = next_task++; t < num_tasks; t = next_task++) {
+            Tour& guide = pool[order[t / 2]];
+            if (t % 2 == 0)
+                results[t] = mixedPathRelinking(solution, guide, graph, &task_intermediates[t]);
+            else
+                results[t] = mixedPathRelinking(guide, solution, graph, &task_intermediates[t]);
+        }
+    };
+
+    vector<thread> threads;
+    for (size_t w = 1; w < num_workers; w++)
+        threads.emplace_back(worker);
+    worker();
+    for (thread& t : threads)
+        t.join();
+
+    // merged in task order, so the outcome does not depend on thread scheduling
+    Tour best_solution = solution;
+    for (size_t t = 0; t < num_tasks; t++) {
+        if (results[t].tour_cost < best_solution.tour_cost)
+            best_solution = results[t];
+        intermediates.insert(intermediates.end(), task_intermediates[t].begin(), task_intermediates[t].end());
+    }
+
+    return best_solution;
+}
+
 int calculateHammingDistance(Tour& solution1, Tour& solution2) {
 
     size_t n = solution1.tour.size();
     int distance = 0;
-    for (size_t i = 1; i < n; ++i) {
-        size_t i1 = (solution1.depot_idx + i) % n; 
-        size_t i2 = (solution2.depot_idx + i) % n;
-        if (solution1.tour[i1] != solution2.tour[i2])
-            ++distance;
-    }
+    const vector<int>& a = solution1.tour;
+    const vector<int>& b = solution2.tour;
+    for (size_t i = 1; i < n; ++i)
+        distance += (a[i] != b[i]);
 
     return distance;
 }
@@ -0,0 +1,278 @@
+#include "preprocessing.hpp"
+#include "parser.hpp"
+#include "construction.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+// drops the relations whose trigger can never be traversed before the target,
+// and those of targets whose triggers all restore the original cost
+static vector<InstanceRelation> usefulRelations(const vector<InstanceArc>& arcs, const vector<unsigned char>& alive,
+                                                const vector<InstanceRelation>& relations) {
+
+    vector<InstanceRelation> kept;
+    vector<unsigned char> changes_cost(arcs.size(), 0);
+
+    for (const InstanceRelation& relation : relations) {
+        const InstanceArc& trigger = arcs[relation.trigger_arc];
+        const InstanceArc& target = arcs[relation.target_arc];
+
+        if (!alive[relation.trigger_arc] || !alive[relation.target_arc])
+            continue;
+        if (relation.trigger_arc == relation.target_arc)
+            continue;
+        // the tour is evaluated from the depot: nothing comes before the arc leaving it or after the one entering it
+        if (target.from == 0 || trigger.to == 0)
+            continue;
+        // trigger right after the target, or both can not be in the same tour; a trigger
+        // leaving the depot is the first arc priced, so it still reaches a target entering it
+        if ((trigger.from == target.to && target.to != 0) || trigger.from == target.from || trigger.to == target.to)
+            continue;
+
+        kept.push_back(relation);
+        if (relation.new_cost != target.cost)
+            changes_cost[relation.target_arc] = 1;
+    }
+
+    // a relation restoring the original cost still matters if another trigger of the same target changes it
+    kept.erase(remove_if(kept.begin(), kept.end(),
+                         [&](const InstanceRelation& relation) { return !changes_cost[relation.target_arc]; }),
+               kept.end());
+
+    return kept;
+}
+
+int preprocessInstance(const Graph& graph, const vector<Arc>& all_arcs,
+                       Graph& reduced_graph, vector<Arc>& reduced_arcs, Reduction& reduction) {
+
+    int n = graph.adj.size();
+    int num_arcs = all_arcs.size();
+
+    vector<InstanceArc> arcs(num_arcs);
+    vector<InstanceRelation> relations;
+    for (int a = 0; a < num_arcs; ++a) {
+        arcs[a] = {all_arcs[a].from, all_arcs[a].to, all_arcs[a].original_cost};
+        for (auto& [target_idx, target_cost] : all_arcs[a].targets)
+            relations.push_back({a, target_idx, target_cost});
+    }
+
+    reduction = Reduction();
+    reduction.original_nodes = n;
+    reduction.original_arcs = num_arcs;
+    reduction.original_relations = relations.size();
+
+    // 1. Forced arcs, propagated until nothing changes
+
+    vector<unsigned char> alive(num_arcs, 1);
+    vector<vector<int>> out_arcs(n), in_arcs(n);
+    vector<int> out_count(n, 0), in_count(n, 0);
+    vector<int> forced_out(n, -1), forced_in(n, -1);
+
+    auto kill = [&](int a) {
+        if (a == -1 || !alive[a])
+            return;
+        alive[a] = 0;
+        out_count[arcs[a].from]--;
+        in_count[arcs[a].to]--;
+    };
+
+    for (int a = 0; a < num_arcs; ++a) {
+        out_arcs[arcs[a].from].push_back(a);
+        in_arcs[arcs[a].to].push_back(a);
+        out_count[arcs[a].from]++;
+        in_count[arcs[a].to]++;
+    }
+    if (n > 1)
+        for (int a = 0; a < num_arcs; ++a)
+            if (arcs[a].from == arcs[a].to)
+                kill(a);
+
+    // returns false if the forced arcs close a subtour
+    auto force = [&](int a) {
+        int u = arcs[a].from, v = arcs[a].to;
+        forced_out[u] = a;
+        forced_in[v] = a;
+        reduction.forced_arcs++;
+
+        for (int b : out_arcs[u])
+            if (b != a) kill(b);
+        for (int b : in_arcs[v])
+            if (b != a) kill(b);
+
+        int head = u, tail = v, path_nodes = 2;
+        while (forced_in[head] != -1 && head != v) {
+            head = arcs[forced_in[head]].from;
+            path_nodes++;
+        }
+        if (head == v)
+            return path_nodes - 1 == n;
+        while (forced_out[tail] != -1) {
+            tail = arcs[forced_out[tail]].to;
+            path_nodes++;
+        }
+
+        // the arc closing the path would end the tour before visiting every node
+        if (path_nodes < n)
+            kill(graph.adj[tail][head]);
+        return true;
+    };
+
+    bool changed = n > 1;
+    while (changed) {
+        changed = false;
+        for (int u = 0; u < n; ++u) {
+            if (out_count[u] == 0 || in_count[u] == 0)
+                return -1;
+
+            if (forced_out[u] == -1 && out_count[u] == 1) {
+                for (int a : out_arcs[u])
+                    if (alive[a] && !force(a))
+                        return -1;
+                changed = true;
+            }
+            if (forced_in[u] == -1 && in_count[u] == 1) {
+                for (int a : in_arcs[u])
+                    if (alive[a] && !force(a))
+                        return -1;
+                changed = true;
+            }
+        }
+    }
+
+    // 2. Relations that can change the cost of some tour
+
+    relations = usefulRelations(arcs, alive, relations);
+
+    vector<unsigned char> plain(num_arcs, 1);
+    for (const InstanceRelation& relation : relations) {
+        plain[relation.trigger_arc] = 0;
+        plain[relation.target_arc] = 0;
+    }
+
+    // 3. Paths of forced arcs without relations become one node
+
+    vector<unsigned char> contracted(num_arcs, 0);
+    // if the whole tour is forced there is nothing left to search, the instance is only cleaned
+    if (reduction.forced_arcs < n)
+        for (int u = 0; u < n; ++u)
+            if (forced_out[u] != -1 && plain[forced_out[u]])
+                contracted[forced_out[u]] = 1;
+
+    auto is_head = [&](int u) { return forced_in[u] == -1 || !contracted[forced_in[u]]; };
+
+    reduction.node_group.assign(n, -1);
+    auto add_group = [&](int head) {
+        vector<int> chain;
+        for (int u = head; ; u = arcs[forced_out[u]].to) {
+            reduction.node_group[u] = reduction.node_chain.size();
+            chain.push_back(u);
+            if (forced_out[u] == -1 || !contracted[forced_out[u]])
+                break;
+        }
+        reduction.node_chain.push_back(chain);
+    };
+
+    int depot_head = 0;
+    while (!is_head(depot_head))
+        depot_head = arcs[forced_in[depot_head]].from;
+    add_group(depot_head);
+    for (int u = 0; u < n; ++u)
+        if (u != depot_head && is_head(u))
+            add_group(u);
+
+    // 4. Compact renumbering
+
+    vector<InstanceArc> new_arcs;
+    vector<int> new_index(num_arcs, -1);
+    for (int a = 0; a < num_arcs; ++a) {
+        if (contracted[a]) {
+            reduction.contracted_arcs++;
+            reduction.fixed_cost += arcs[a].cost;
+            continue;
+        }
+        int from = reduction.node_group[arcs[a].from];
+        int to = reduction.node_group[arcs[a].to];
+        if (!alive[a] || (from == to && n > 1))
+            continue;
+        new_index[a] = new_arcs.size();
+        reduction.arc_origin.push_back(a);
+        new_arcs.push_back({from, to, arcs[a].cost});
+    }
+
+    vector<InstanceRelation> new_relations;
+    for (const InstanceRelation& relation : relations)
+        if (new_index[relation.trigger_arc] != -1 && new_index[relation.target_arc] != -1)
+            new_relations.push_back({new_index[relation.trigger_arc], new_index[relation.target_arc], relation.new_cost});
+
+    // contraction can create new arcs leaving or entering the depot node
+    new_relations = usefulRelations(new_arcs, vector<unsigned char>(new_arcs.size(), 1), new_relations);
+
+    int reduced_n = reduction.node_chain.size();
+    vector<int> arc_order;
+    buildInstance(reduced_n, new_arcs, new_relations, reduced_graph, reduced_arcs, &arc_order);
+
+    // buildInstance sorted the arcs, arc_origin follows
+    vector<int> arc_origin(arc_order.size());
+    for (size_t k = 0; k < arc_order.size(); ++k)
+        arc_origin[k] = reduction.arc_origin[arc_order[k]];
+    reduction.arc_origin = arc_origin;
+
+    reduction.reduced_nodes = reduced_n;
+    reduction.reduced_arcs = new_arcs.size();
+    reduction.reduced_relations = new_relations.size();
+
+    return 0;
+}
+
+void expandTour(const Reduction& reduction, const Tour& reduced_tour, Tour& tour) {
+
+    size_t m = reduced_tour.tour.size();
+
+    tour.tour.clear();
+    for (size_t k = 0; k < m; ++k) {
+        const vector<int>& chain = reduction.node_chain[reduced_tour.tour[k]];
+        tour.tour.insert(tour.tour.end(), chain.begin(), chain.end());
+    }
+
+    anchorTour(tour);
+    tour.tour_cost = reduced_tour.tour_cost + reduction.fixed_cost;
+}
+
+bool reduceTour(const Reduction& reduction, const Tour& tour, Tour& reduced_tour) {
+
+    int n = tour.tour.size();
+    if (n != reduction.original_nodes)
+        return false;
+
+    // start at the first node of the depot's path, every path must then appear in one piece
+    int start = find(tour.tour.begin(), tour.tour.end(), reduction.node_chain[0][0]) - tour.tour.begin();
+    if (start == n)
+        return false;
+
+    reduced_tour.tour.clear();
+    for (int k = 0; k < n; ) {
+        int node = tour.tour[(start + k) % n];
+        if (node < 0 || node >= n)
+            return false;
+        int group = reduction.node_group[node];
+        const vector<int>& chain = reduction.node_chain[group];
+        for (int c : chain) {
+            if (k == n || tour.tour[(start + k) % n] != c)
+                return false;
+            k++;
+        }
+        reduced_tour.tour.push_back(group);
+    }
+
+    anchorTour(reduced_tour);
+    reduced_tour.tour_cost = tour.tour_cost - reduction.fixed_cost;
+    return true;
+}
+
+void printReduction(const Reduction& reduction) {
+    cout << "Preprocessing: Nodes " << reduction.original_nodes << " -> " << reduction.reduced_nodes
+         << ", Arcs " << reduction.original_arcs << " -> " << reduction.reduced_arcs
+         << ", Relations " << reduction.original_relations << " -> " << reduction.reduced_relations << endl;
+    cout << "Forced Arcs: " << reduction.forced_arcs << " (" << reduction.contracted_arcs
+         << " contracted, Fixed Cost=" << reduction.fixed_cost << ")" << endl;
+}
@@ -0,0 +1,102 @@
+#include "reactive.hpp"
+
+#include <cmath>
+
+void initReactiveGRASP(ReactiveGRASP& reactive, double base_param) {
+
+    // without a base parameter the multiples below would all collapse to zero
+    if (base_param <= 0)
+        base_param = 1.0;
+
+    const double multipliers[] = {0.25, 0.5, 1.0, 2.0, 4.0};
+
+    reactive.options.clear();
+    reactive.options.push_back({PerturbationType::NONE, 0.0, 0.0});
+    for (double m : multipliers)
+        reactive.options.push_back({PerturbationType::ADDITIVE, m * base_param, 0.0});
+
+    // the multiplicative perturbation scales every arc by beta * U(0, 1): beta is a common
+    // factor and never changes which tour the MIP picks, so one option covers all of them
+    reactive.options.push_back({PerturbationType::MULTIPLICATIVE, 1.0, 0.0});
+
+    for (ReactiveOption& option : reactive.options)
+        option.probability = 1.0 / reactive.options.size();
+
+    reactive.best_cost = numeric_limits<double>::infinity();
+    reactive.iterations_since_update = 0;
+}
+
+int selectReactiveOption(ReactiveGRASP& reactive, mt19937& gen) {
+
+    uniform_real_distribution<> dist(0.0, 1.0);
+    double r = dist(gen);
+
+    double cumulative = 0.0;
+    for (size_t i = 0; i < reactive.options.size(); ++i) {
+        cumulative += reactive.options[i].probability;
+        if (r < cumulative)
+            return i;
+    }
+
+    return reactive.options.size() - 1; // floating-point fallback
+}
+
+void recordReactiveResult(ReactiveGRASP& reactive, int option_idx, double tour_cost) {
+
+    ReactiveOption& option = reactive.options[option_idx];
+    option.cost_sum += tour_cost;
+    option.count++;
+
+    if (tour_cost < reactive.best_cost)
+        reactive.best_cost = tour_cost;
+
+    if (++reactive.iterations_since_update >= REACTIVE_BLOCK) {
+        updateReactiveProbabilities(reactive);
+        reactive.iterations_since_update = 0;
+    }
+}
+
+void updateReactiveProbabilities(ReactiveGRASP& reactive) {
+
+    // the ratio best/mean only measures quality for positive costs
+    if (reactive.best_cost <= 0)
+        return;
+
+    vector<double> q(reactive.options.size());
+    double total = 0.0;
+
+    for (size_t i = 0; i < reactive.options.size(); ++i) {
+        const ReactiveOption& option = reactive.options[i];
+        // untried options are treated as if they matched the best tour, so they keep being sampled
+        double mean_cost = (option.count > 0) ? option.cost_sum / option.count : reactive.best_cost;
+        q[i] = pow(reactive.best_cost / mean_cost, REACTIVE_DELTA);
+        total += q[i];
+    }
+
+    if (total <= 0)
+        return;
+
+    for (size_t i = 0; i < reactive.options.size(); ++i)
+        reactive.options[i].probability = q[i] / total;
+}
+
+void printReactiveDistribution(const ReactiveGRASP& reactive) {
+
+    cout << "Reactive GRASP Distribution:" << endl;
+
+    for (const ReactiveOption& option : reactive.options) {
+        string type_str;
+        switch (option.type) {
+            case PerturbationType::NONE: type_str = "NONE"; break;
+            case PerturbationType::ADDITIVE: type_str = "ADDITIVE"; break;
+            case PerturbationType::MULTIPLICATIVE: type_str = "MULTIPLICATIVE"; break;
+        }
+
+        cout << "  Type=" << type_str << ", Param=" << option.param
+             << ", Prob=" << option.probability
+             << ", Uses=" << option.count;
+        if (option.count > 0)
+            cout << ", Mean Cost=" << option.cost_sum / option.count;
+        cout << endl;
+    }
+}
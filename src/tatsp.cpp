@@ -0,0 +1,335 @@
+#include "tatsp.hpp"
+#include "datatypes.hpp"
+#include "construction.hpp"
+#include "reactive.hpp"
+#include "ils.hpp"
+#include "improvement.hpp"
+#include "island.hpp"
+#include "preprocessing.hpp"
+#include "local_search.hpp"
+#include "path_relinking.hpp"
+#include "checkpoint.hpp"
+#include "window_dp.hpp"
+#include "diagnostics.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+static bool validConfig(const SolverConfig& config) {
+
+    if (config.pert_parameter < 0) {
+        diagnostics() << "Error: Perturbation parameter must be non-negative." << endl;
+        return false;
+    }
+    if (config.time_limit <= 0) {
+        diagnostics() << "Error: Time limit must be positive." << endl;
+        return false;
+    }
+    if (config.ils_kicks < 0 || config.ils_threshold < 0) {
+        diagnostics() << "Error: ILS kicks and threshold must be non-negative." << endl;
+        return false;
+    }
+    if (config.engine.max_iterations < 0 || config.engine.time_limit < 0 || config.engine.tabu_tenure < 0) {
+        diagnostics() << "Error: Engine budgets and tabu tenure must be non-negative." << endl;
+        return false;
+    }
+    if (config.engine.dp_window != 0 &&
+        (config.engine.dp_window < DP_WINDOW_MIN || config.engine.dp_window > DP_WINDOW_MAX)) {
+        diagnostics() << "Error: DP window must be 0 (disabled) or between " << DP_WINDOW_MIN << " and " << DP_WINDOW_MAX << "." << endl;
+        return false;
+    }
+    if (config.checkpoint_interval <= 0) {
+        diagnostics() << "Error: Checkpoint interval must be positive." << endl;
+        return false;
+    }
+    if (config.pr_threads < 0) {
+        diagnostics() << "Error: The number of Path Relinking threads must be non-negative." << endl;
+        return false;
+    }
+    if (config.pr_guides < 1 || config.pr_guides > (int)POOL_SIZE) {
+        diagnostics() << "Error: The number of Path Relinking guides must be between 1 and the pool size (" << POOL_SIZE << ")." << endl;
+        return false;
+    }
+    if (config.migration_interval <= 0) {
+        diagnostics() << "Error: Migration interval must be positive." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+int solveTATSP(const Graph& input_graph, const vector<Arc>& input_arcs, const SolverConfig& config,
+               SolverResult& result, ImprovementCallback on_improvement) {
+
+    // error messages of this call only with verbose, the caller may not own the terminal
+    DiagnosticsScope diagnostics_scope(config.verbose);
+
+    if (!validConfig(config))
+        return -1;
+
+    // the construction perturbs arc costs, so every call works on its own copy of the arcs;
+    // copies of the graph share its (read-only) compact instance
+    Graph graph = input_graph;
+    vector<Arc> all_arcs = input_arcs;
+
+    // with preprocessing the search runs on the reduced instance, while the tours read from
+    // files, exchanged with other islands or handed back to the caller keep the original ids
+    Reduction reduction;
+    Graph original_graph;
+    if (config.preprocess) {
+        if (preprocessInstance(input_graph, input_arcs, graph, all_arcs, reduction) == -1) {
+            if (config.verbose)
+                cout << "Preprocessing: the instance has no Hamiltonian cycle." << endl;
+            result = SolverResult();
+            return 0;
+        }
+        original_graph = input_graph;
+        if (config.verbose)
+            printReduction(reduction);
+    }
+    Graph& io_graph = config.preprocess ? original_graph : graph;
+
+    auto to_original = [&](const Tour& tour) {
+        if (!config.preprocess || tour.tour.empty())
+            return tour;
+        Tour expanded;
+        expandTour(reduction, tour, expanded);
+        return expanded;
+    };
+    auto to_search = [&](Tour& tour) {
+        if (!config.preprocess)
+            return true;
+        Tour reduced;
+        if (!reduceTour(reduction, tour, reduced))
+            return false;
+        tour = reduced;
+        return true;
+    };
+
+    EngineConfig engine_config = config.engine;
+
+    auto start_time = chrono::steady_clock::now();
+
+    mt19937 gen_grasp, gen_pr, gen_ils, gen_engine;
+
+    // every generator whose state is saved in (and restored from) a checkpoint
+    vector<mt19937*> rngs = {&gen_grasp, &gen_pr, &gen_ils, &gen_engine};
+
+    if (config.seed == 0) {
+        random_device rd;
+        for (mt19937* rng : rngs)
+            rng->seed(rd());
+    }
+    else {
+        seed_seq seeds{config.seed};
+        vector<unsigned int> rng_seeds(rngs.size());
+        seeds.generate(rng_seeds.begin(), rng_seeds.end());
+        for (size_t k = 0; k < rngs.size(); ++k)
+            rngs[k]->seed(rng_seeds[k]);
+    }
+
+    int best_iteration = 0;
+
+    Tour best_tour;
+    best_tour.tour_cost = numeric_limits<double>::infinity();
+    int count = 0;
+    vector<Tour> pool;
+    pool.reserve(POOL_SIZE);
+
+    ReactiveGRASP reactive;
+    if (config.reactive)
+        initReactiveGRASP(reactive, config.pert_parameter);
+
+    ILSState ils_state;
+
+    auto elapsed_seconds = [&]() {
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start_time;
+        return elapsed.count();
+    };
+
+    auto new_incumbent = [&](Tour& tour) {
+        best_tour = tour;
+        best_iteration = count;
+        if (on_improvement)
+            on_improvement(to_original(best_tour), count, elapsed_seconds());
+    };
+
+    auto save_checkpoint = [&]() {
+        Tour saved_best = to_original(best_tour);
+        vector<Tour> saved_pool;
+        for (Tour& tour : pool)
+            saved_pool.push_back(to_original(tour));
+        writeCheckpoint(config.checkpoint_file, saved_best, saved_pool, rngs);
+    };
+
+    // warm start: the incumbent (and the pool) come from a previous run
+    if (!config.resume_file.empty()) {
+        if (!readCheckpoint(config.resume_file, io_graph, best_tour, pool, rngs) || !to_search(best_tour)) {
+            diagnostics() << "Error: Cannot resume from '" << config.resume_file << "'." << endl;
+            return -1;
+        }
+        pool.erase(remove_if(pool.begin(), pool.end(), [&](Tour& tour) { return !to_search(tour); }), pool.end());
+        if (pool.size() > POOL_SIZE)
+            pool.resize(POOL_SIZE);
+        if (config.verbose)
+            cout << "Resumed from " << config.resume_file << ": Best Cost=" << to_original(best_tour).tour_cost
+                 << ", Pool Size=" << pool.size() << endl;
+    }
+    if (!config.init_file.empty()) {
+        Tour init_tour;
+        if (!readTourFile(config.init_file, io_graph, init_tour) || !to_search(init_tour))
+            return -1;
+        if (init_tour.tour_cost < best_tour.tour_cost)
+            best_tour = init_tour;
+        if (config.path_relinking && pool.size() < POOL_SIZE)
+            pool.push_back(init_tour);
+        if (config.verbose)
+            cout << "Initial tour from " << config.init_file << ": Cost=" << to_original(init_tour).tour_cost << endl;
+    }
+    if (config.ils_only && !best_tour.tour.empty())
+        initILS(ils_state, best_tour);
+
+    // a warm-started incumbent is reported at once, like any later one
+    if (on_improvement && !best_tour.tour.empty())
+        on_improvement(to_original(best_tour), count, elapsed_seconds());
+
+    Island island;
+    if (!config.island_name.empty()) {
+        if (!attachIsland(island, config.island_name, config.island_id, io_graph.adj.size()))
+            return -1;
+        if (config.verbose)
+            cout << "Island " << config.island_id << " attached to " << island.name << endl;
+    }
+    vector<Tour> migrants;
+
+    auto last_checkpoint = chrono::steady_clock::now();
+
+    while (elapsed_seconds() < config.time_limit) {
+
+        if (!config.checkpoint_file.empty() && !best_tour.tour.empty()) {
+            chrono::duration<double> since_checkpoint = chrono::steady_clock::now() - last_checkpoint;
+            if (since_checkpoint.count() >= config.checkpoint_interval) {
+                save_checkpoint();
+                last_checkpoint = chrono::steady_clock::now();
+            }
+        }
+
+        // island model: publish one tour and merge everything the other islands sent
+        if (island.header && count > 0 && count % config.migration_interval == 0 && !best_tour.tour.empty()) {
+            Tour emigrant = best_tour;
+            if (config.migration_policy == MigrationPolicy::RANDOM_ELITE && !pool.empty()) {
+                uniform_int_distribution<> pick(0, pool.size() - 1);
+                emigrant = pool[pick(gen_pr)];
+            }
+            emigrant = to_original(emigrant);
+            sendMigrant(island, emigrant);
+
+            migrants.clear();
+            receiveMigrants(island, migrants);
+            for (Tour& migrant : migrants) {
+                // shared memory is not trusted: the tour is checked and re-priced locally
+                if (!validateTour(migrant, io_graph) || !to_search(migrant))
+                    continue;
+                if (config.path_relinking) {
+                    if (pool.size() < POOL_SIZE)
+                        pool.push_back(migrant);
+                    else
+                        updatePool(migrant, pool);
+                }
+                if (config.ils_only && ils_state.initialized && migrant.tour_cost < ils_state.best.tour_cost)
+                    initILS(ils_state, migrant);
+                if (migrant.tour_cost < best_tour.tour_cost)
+                    new_incumbent(migrant);
+            }
+        }
+
+        // pure ILS: after the first construction every iteration is one kick, no MIP call
+        if (config.ils_only && ils_state.initialized) {
+            ilsStep(ils_state, graph, config.acceptance, config.ils_threshold, engine_config, gen_ils);
+            if (ils_state.best.tour_cost < best_tour.tour_cost)
+                new_incumbent(ils_state.best);
+            count++;
+            continue;
+        }
+
+        // in reactive mode each iteration draws its own (type, parameter) pair
+        PerturbationType iter_pert_type = config.pert_type;
+        double iter_pert_parameter = config.pert_parameter;
+        int reactive_option = -1;
+        if (config.reactive) {
+            reactive_option = selectReactiveOption(reactive, gen_grasp);
+            iter_pert_type = reactive.options[reactive_option].type;
+            iter_pert_parameter = reactive.options[reactive_option].param;
+        }
+
+        Tour solution_tour;
+        int construct_status = constructiveHeuristic(graph, all_arcs, solution_tour, iter_pert_type, iter_pert_parameter, gen_grasp);
+
+        // This iteration failed to find a feasible solution, skip to the next
+        if (construct_status == -1) {
+            count++;
+            continue;
+        }
+
+        improveSolution(solution_tour, graph, engine_config, gen_engine);
+
+        if (config.reactive)
+            recordReactiveResult(reactive, reactive_option, solution_tour.tour_cost);
+
+        if (config.ils_only || config.ils_kicks > 0) {
+            initILS(ils_state, solution_tour);
+            for (int k = 0; k < config.ils_kicks && elapsed_seconds() < config.time_limit; ++k)
+                ilsStep(ils_state, graph, config.acceptance, config.ils_threshold, engine_config, gen_ils);
+            solution_tour = ils_state.best;
+        }
+
+        if (config.path_relinking) {
+            if (pool.size() < POOL_SIZE) {
+                pool.push_back(solution_tour);
+            }
+
+            else if (config.pr_guides > 1) {
+                vector<Tour> intermediates;
+                solution_tour = multiGuidePathRelinking(solution_tour, pool, config.pr_guides, config.pr_threads, graph, intermediates);
+                improveSolution(solution_tour, graph, engine_config, gen_engine);
+                for (Tour& intermediate : intermediates)
+                    updatePool(intermediate, pool);
+                updatePool(solution_tour, pool);
+            }
+
+            else {
+                Tour guidingSolution = pool[selectGuidingSolution(solution_tour, pool, gen_pr)];
+                solution_tour = mixedPathRelinking(solution_tour, guidingSolution, graph);
+                improveSolution(solution_tour, graph, engine_config, gen_engine);
+                updatePool(solution_tour, pool);
+            }
+
+        }
+
+        if (solution_tour.tour_cost < best_tour.tour_cost)
+            new_incumbent(solution_tour);
+
+        count++;
+    }
+
+    if (!config.checkpoint_file.empty() && !best_tour.tour.empty())
+        save_checkpoint();
+
+    best_tour = to_original(best_tour);
+
+    // the final incumbent is left for islands that are still running
+    if (island.header) {
+        if (!best_tour.tour.empty())
+            sendMigrant(island, best_tour);
+        detachIsland(island);
+    }
+
+    result.best_tour = best_tour;
+    result.stats.iterations = count;
+    result.stats.best_iteration = best_iteration;
+    result.stats.elapsed = elapsed_seconds();
+    result.stats.reactive = reactive;
+    result.stats.reduction = reduction;
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "tatsp_c.h"
+#include "tatsp.hpp"
+#include "datatypes.hpp"
+
+#include <cstring>
+
+// the version 5 layout, the oldest one the library accepts
+const size_t TATSP_CONFIG_MIN_SIZE = offsetof(tatsp_config, pr_guides) + sizeof(int);
+
+static void fillDefaultConfig(tatsp_config* config) {
+
+    SolverConfig defaults;
+
+    config->struct_size = sizeof(tatsp_config);
+    config->pert_type = TATSP_PERT_ADDITIVE;
+    config->pert_parameter = defaults.pert_parameter;
+    config->time_limit = defaults.time_limit;
+    config->path_relinking = defaults.path_relinking;
+    config->reactive = defaults.reactive;
+    config->ils_kicks = defaults.ils_kicks;
+    config->ils_only = defaults.ils_only;
+    config->acceptance = TATSP_ACCEPT_BETTER;
+    config->ils_threshold = defaults.ils_threshold;
+    config->engine = TATSP_ENGINE_LOCAL_SEARCH;
+    config->engine_iterations = defaults.engine.max_iterations;
+    config->engine_time_limit = defaults.engine.time_limit;
+    config->tabu_tenure = defaults.engine.tabu_tenure;
+    config->checkpoint_file = nullptr;
+    config->checkpoint_interval = defaults.checkpoint_interval;
+    config->resume_file = nullptr;
+    config->init_file = nullptr;
+    config->seed = defaults.seed;
+    config->preprocess = defaults.preprocess;
+    config->dp_window = defaults.engine.dp_window;
+    config->pr_guides = defaults.pr_guides;
+    config->pr_threads = defaults.pr_threads;
+}
+
+void tatsp_init_config(tatsp_config* config, size_t struct_size) {
+
+    if (!config || struct_size < sizeof(size_t))
+        return;
+
+    // a caller built against an older header has a shorter struct
+    tatsp_config defaults;
+    fillDefaultConfig(&defaults);
+    defaults.struct_size = struct_size;
+    memcpy(config, &defaults, min(struct_size, sizeof(tatsp_config)));
+}
+
+static bool convertConfig(const tatsp_config* in, SolverConfig& out) {
+
+    switch (in->pert_type) {
+        case TATSP_PERT_NONE: out.pert_type = PerturbationType::NONE; break;
+        case TATSP_PERT_ADDITIVE: out.pert_type = PerturbationType::ADDITIVE; break;
+        case TATSP_PERT_MULTIPLICATIVE: out.pert_type = PerturbationType::MULTIPLICATIVE; break;
+        default: return false;
+    }
+
+    switch (in->acceptance) {
+        case TATSP_ACCEPT_BETTER: out.acceptance = AcceptanceCriterion::BETTER; break;
+        case TATSP_ACCEPT_RANDOM_WALK: out.acceptance = AcceptanceCriterion::RANDOM_WALK; break;
+        case TATSP_ACCEPT_THRESHOLD: out.acceptance = AcceptanceCriterion::THRESHOLD; break;
+        default: return false;
+    }
+
+    switch (in->engine) {
+        case TATSP_ENGINE_LOCAL_SEARCH: out.engine.engine = ImprovementEngine::LOCAL_SEARCH; break;
+        case TATSP_ENGINE_SIMULATED_ANNEALING: out.engine.engine = ImprovementEngine::SIMULATED_ANNEALING; break;
+        case TATSP_ENGINE_TABU_SEARCH: out.engine.engine = ImprovementEngine::TABU_SEARCH; break;
+        default: return false;
+    }
+
+    out.pert_parameter = in->pert_parameter;
+    out.time_limit = in->time_limit;
+    out.path_relinking = in->path_relinking != 0;
+    out.reactive = in->reactive != 0;
+    out.ils_kicks = in->ils_kicks;
+    out.ils_only = in->ils_only != 0;
+    out.ils_threshold = in->ils_threshold;
+    out.engine.max_iterations = in->engine_iterations;
+    out.engine.time_limit = in->engine_time_limit;
+    out.engine.tabu_tenure = in->tabu_tenure;
+    out.checkpoint_file = in->checkpoint_file ? in->checkpoint_file : "";
+    out.checkpoint_interval = in->checkpoint_interval;
+    out.resume_file = in->resume_file ? in->resume_file : "";
+    out.init_file = in->init_file ? in->init_file : "";
+    out.seed = in->seed;
+    out.preprocess = in->preprocess != 0;
+    out.engine.dp_window = in->dp_window;
+    out.pr_guides = in->pr_guides;
+    out.pr_threads = in->pr_threads;
+    out.verbose = false;
+
+    return true;
+}
+
+static int solve(int num_nodes,
+                 const tatsp_arc* arcs, int num_arcs,
+                 const tatsp_relation* relations, int num_relations,
+                 const tatsp_config* config,
+                 tatsp_callback callback, void* user_data,
+                 int* best_tour, double* best_cost, tatsp_stats* stats) {
+
+    if (num_nodes <= 0 || num_arcs < 0 || num_relations < 0 || !config || !best_tour)
+        return -1;
+
+    // only the fields the caller knows about are read, the later ones keep their defaults;
+    // a larger struct comes from a newer header whose fields this library cannot honour
+    if (config->struct_size < TATSP_CONFIG_MIN_SIZE || config->struct_size > sizeof(tatsp_config))
+        return -1;
+    tatsp_config known;
+    fillDefaultConfig(&known);
+    memcpy(&known, config, config->struct_size);
+    config = &known;
+
+    vector<InstanceArc> instance_arcs(num_arcs);
+    for (int k = 0; k < num_arcs; ++k) {
+        if (arcs[k].from < 0 || arcs[k].from >= num_nodes || arcs[k].to < 0 || arcs[k].to >= num_nodes)
+            return -1;
+        instance_arcs[k] = {arcs[k].from, arcs[k].to, arcs[k].cost};
+    }
+
+    vector<InstanceRelation> instance_relations(num_relations);
+    for (int k = 0; k < num_relations; ++k) {
+        if (relations[k].trigger_arc < 0 || relations[k].trigger_arc >= num_arcs ||
+            relations[k].target_arc < 0 || relations[k].target_arc >= num_arcs)
+            return -1;
+        instance_relations[k] = {relations[k].trigger_arc, relations[k].target_arc, relations[k].new_cost};
+    }
+
+    SolverConfig solver_config;
+    if (!convertConfig(config, solver_config))
+        return -1;
+
+    Graph graph;
+    vector<Arc> all_arcs;
+    buildInstance(num_nodes, instance_arcs, instance_relations, graph, all_arcs);
+
+    ImprovementCallback on_improvement = nullptr;
+    if (callback) {
+        on_improvement = [&](const Tour& tour, int iteration, double elapsed) {
+            callback(tour.tour.data(), num_nodes, tour.tour_cost, iteration, elapsed, user_data);
+        };
+    }
+
+    SolverResult result;
+    if (solveTATSP(graph, all_arcs, solver_config, result, on_improvement) == -1)
+        return -1;
+
+    if (stats) {
+        stats->iterations = result.stats.iterations;
+        stats->best_iteration = result.stats.best_iteration;
+        stats->elapsed = result.stats.elapsed;
+    }
+
+    if (result.best_tour.tour.empty())
+        return 1;
+
+    Tour& tour = result.best_tour;
+    for (int i = 0; i < num_nodes; ++i)
+        best_tour[i] = tour.tour[i];
+    if (best_cost)
+        *best_cost = tour.tour_cost;
+
+    return 0;
+}
+
+int tatsp_solve(int num_nodes,
+                const tatsp_arc* arcs, int num_arcs,
+                const tatsp_relation* relations, int num_relations,
+                const tatsp_config* config,
+                tatsp_callback callback, void* user_data,
+                int* best_tour, double* best_cost, tatsp_stats* stats) {
+
+    // exceptions (bad_alloc, Gurobi errors, ...) must not cross the C boundary
+    try {
+        return solve(num_nodes, arcs, num_arcs, relations, num_relations, config,
+                     callback, user_data, best_tour, best_cost, stats);
+    } catch (...) {
+        return -1;
+    }
+}
@@ -0,0 +1,144 @@
+#include "window_dp.hpp"
+#include "compact_instance.hpp"
+#include "delta_evaluation.hpp"
+
+#include <limits>
+
+// cost of arc a placed right after the fixed prefix [0, prefix_end): only triggers there count
+static double prefixCost(const DeltaEvaluator& ev, Graph& graph, int a, int prefix_end) {
+
+    return visitCompactInstance(graph, [&](const auto& instance) {
+        // triggers are in arc order, so the later of two prefix triggers is the one kept
+        int best_pos = -1;
+        double cost = instance.original_cost[a];
+        for (uint32_t r = instance.trigger_begin[a]; r < instance.trigger_begin[a + 1]; ++r) {
+            int pos = arcPosition(ev, graph, instance.triggers[r].arc);
+            if (pos != -1 && pos < prefix_end && pos >= best_pos) {
+                best_pos = pos;
+                cost = instance.triggers[r].cost;
+            }
+        }
+        return cost;
+    });
+}
+
+// best order of seq[first, first + k) between seq[first - 1] and the node after the window;
+// returns its DP cost and writes it to new_nodes (infinity if no feasible order exists)
+static double solveWindow(DeltaEvaluator& ev, Graph& graph, WindowDPTable& table,
+                          int first, int k, vector<int>& new_nodes) {
+
+    const double inf = numeric_limits<double>::infinity();
+    int n = ev.seq.size();
+    int prefix_end = first - 1;     // arcs before the one entering the window
+    int before = ev.seq[first - 1];
+    int after = ev.seq[(first + k) % n];
+    const int* w = &ev.seq[first];
+
+    double in_cost[DP_WINDOW_MAX], out_cost[DP_WINDOW_MAX];
+    for (int x = 0; x < k; ++x) {
+        int a = graph.adj[before][w[x]];
+        in_cost[x] = (a == -1) ? inf : prefixCost(ev, graph, a, prefix_end);
+        a = graph.adj[w[x]][after];
+        out_cost[x] = (a == -1) ? inf : prefixCost(ev, graph, a, prefix_end);
+    }
+
+    table.arc_cost.assign(k * k, inf);
+    table.succ.assign(k, 0);
+    for (int x = 0; x < k; ++x) {
+        for (int y = 0; y < k; ++y) {
+            int a = (x == y) ? -1 : graph.adj[w[x]][w[y]];
+            if (a == -1)
+                continue;
+            table.arc_cost[x * k + y] = prefixCost(ev, graph, a, prefix_end);
+            table.succ[x] |= 1u << y;
+        }
+    }
+
+    unsigned int full = (1u << k) - 1;
+    table.cost.assign((size_t)(full + 1) * k, inf);
+    table.parent.resize((size_t)(full + 1) * k);
+
+    for (int x = 0; x < k; ++x)
+        table.cost[(size_t)(1u << x) * k + x] = in_cost[x];
+
+    // a set is only extended into larger sets, so increasing order is a valid DP order
+    for (unsigned int S = 1; S < full; ++S) {
+        const double* row = &table.cost[(size_t)S * k];
+        for (unsigned int m = S; m; m &= m - 1) {
+            int u = __builtin_ctz(m);
+            double value = row[u];
+            if (value == inf)
+                continue;
+            for (unsigned int next = table.succ[u] & ~S; next; next &= next - 1) {
+                int v = __builtin_ctz(next);
+                size_t idx = (size_t)(S | (1u << v)) * k + v;
+                double candidate = value + table.arc_cost[u * k + v];
+                if (candidate < table.cost[idx]) {
+                    table.cost[idx] = candidate;
+                    table.parent[idx] = u;
+                }
+            }
+        }
+    }
+
+    double best = inf;
+    int last = -1;
+    for (int u = 0; u < k; ++u) {
+        double value = table.cost[(size_t)full * k + u] + out_cost[u];
+        if (value < best) {
+            best = value;
+            last = u;
+        }
+    }
+
+    if (last == -1)
+        return inf;
+
+    new_nodes.resize(k);
+    unsigned int S = full;
+    for (int pos = k - 1; pos >= 0; --pos) {
+        new_nodes[pos] = w[last];
+        int prev = table.parent[(size_t)S * k + last];
+        S &= ~(1u << last);
+        last = prev;
+    }
+
+    return best;
+}
+
+bool windowDP(Tour& current_solution, Graph& graph, int window, DeltaEvaluator& ev) {
+
+    // an evaluator left empty by initDeltaEvaluator: the tour is infeasible
+    if (ev.seq.size() != current_solution.tour.size())
+        return false;
+
+    int n = ev.seq.size();
+    int k = min(window, n - 1);
+    if (k < DP_WINDOW_MIN)
+        return false;
+
+    WindowDPTable table;
+    vector<int> new_nodes;
+
+    for (int first = 1; first + k - 1 <= n - 1; ++first) {
+
+        double dp_cost = solveWindow(ev, graph, table, first, k, new_nodes);
+
+        // same prefix-aware pricing for the current order, so the two are comparable
+        double current_cost = 0;
+        for (int p = first - 1; p < first + k; ++p)
+            current_cost += prefixCost(ev, graph, ev.arc_at[p], first - 1);
+
+        if (!(dp_cost < current_cost))
+            continue;
+
+        double delta = evaluateSegmentDelta(ev, graph, first, first + k - 1, new_nodes);
+        if (delta < 0) {
+            commitSegment(ev, graph, first, new_nodes);
+            current_solution = evaluatorTour(ev);
+            return true;
+        }
+    }
+
+    return false;
+}